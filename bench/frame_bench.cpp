@@ -0,0 +1,564 @@
+// Headless frame benchmark for the application UI
+//
+// Builds the same frames as the desktop application (DrawMainWindow) with
+// the null ImGui backend: a fixed display size, a CPU-built font atlas and
+// no renderer. Steps a number of frames per task count and scenario and
+// prints CPU time per frame, draw data size and heap allocations per frame.
+// Needs no display or GPU.
+//
+// Usage: frame_bench [--sizes 0,1000,100000,1000000] [--frames 600]
+//                    [--scenario idle|scroll|modal|all] [--profiler] [--trace <trace.json>]
+//                    [--idle-seconds S] [--assert-zero-alloc] [--dir <scratch directory>]
+//
+// --profiler opens the frame profiler window, so zones are recorded and the
+// window is part of every frame (compare with a run without it for overhead).
+// --idle-seconds compares the CPU use of an untouched window with the loop
+// rendering every vsync and rendering on demand.
+// --assert-zero-alloc exits with status 1 if any measured (post warm-up)
+// frame allocates, through operator new or the ImGui allocator.
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <filesystem>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <ctime>
+#include "imgui.h"
+#include "imgui_impl_null.h"
+#include "task_manager.h"
+#include "trace_recorder.h"
+#include "task_view_model.h"
+#include "task_ui.h"
+#include "frame_profiler.h"
+#include "render_scheduler.h"
+
+using bench_clock = std::chrono::steady_clock;
+
+// Heap allocations made through operator new (application and standard library)
+// on the thread that builds the frames; background threads such as the save
+// worker start at unpredictable times and are not part of the frame cost
+static std::atomic<size_t> g_heap_allocations{0};
+static thread_local bool g_count_heap_allocations = false;
+
+// Allocations and bytes requested by ImGui (through SetAllocatorFunctions)
+static size_t g_imgui_allocations = 0;
+static size_t g_imgui_bytes = 0;
+
+void* operator new(size_t size) {
+    if (g_count_heap_allocations) {
+        g_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+// ImGui allocation hook
+static void* imgui_alloc(size_t size, void*) {
+    g_imgui_allocations++;
+    g_imgui_bytes += size;
+    return std::malloc(size);
+}
+
+// ImGui free hook
+static void imgui_free(void* ptr, void*) {
+    std::free(ptr);
+}
+
+// What the simulated user does while frames are measured
+enum class Scenario {
+    Idle,       // Main window only, no input
+    Scroll,     // Mouse wheel over the uncompleted tasks panel every frame
+    Modal       // "Mark Tasks" modal open, mouse wheel over its left column
+};
+
+// Command line settings
+struct BenchOptions {
+    std::vector<size_t> sizes = {0, 1000, 100000, 1000000};    // Task counts to test
+    size_t frames = 600;                    // Measured frames per run
+    std::vector<Scenario> scenarios = {Scenario::Idle, Scenario::Scroll, Scenario::Modal};
+    bool profiler = false;                  // Open the frame profiler window during the runs
+    bool assert_zero_alloc = false;         // Fail if a measured frame allocates
+    double idle_seconds = 0.0;              // Wall time of each idle CPU measurement (0 = skip)
+    std::string trace_path;                 // Chrome trace of the whole run (empty = no capture)
+    std::filesystem::path dir;              // Scratch directory for the data file
+};
+
+// Per-frame measurements of one run
+struct FrameStats {
+    std::vector<double> cpu_us;             // NewFrame() .. RenderDrawData() time
+    double vertices = 0.0;                  // Mean ImDrawData::TotalVtxCount
+    double indices = 0.0;                   // Mean ImDrawData::TotalIdxCount
+    double draw_lists = 0.0;                // Mean ImDrawData::CmdListsCount
+    double imgui_allocations = 0.0;         // Mean ImGui allocations per frame
+    double imgui_bytes = 0.0;               // Mean ImGui bytes allocated per frame
+    double heap_allocations = 0.0;          // Mean operator new calls per frame
+    size_t max_heap_allocations = 0;        // Worst frame
+    int texture_updates = 0;                // Font atlas updates during measured frames
+};
+
+static const ImVec2 display_size(1200, 800);    // Default window size of the application
+static const size_t warmup_frames = 30;         // Unmeasured frames (atlas build, layout settling)
+
+// Scenario name for output
+static const char* scenario_name(Scenario scenario) {
+    switch (scenario) {
+        case Scenario::Idle: return "idle";
+        case Scenario::Scroll: return "scroll";
+        case Scenario::Modal: return "modal";
+    }
+    return "?";
+}
+
+// Value at quantile `q` of sorted samples
+static double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+// Remove a data file and its journal
+static void remove_data_files(const std::filesystem::path& path) {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    std::filesystem::remove(path.string() + ".log", ec);
+    std::filesystem::remove(path.string() + ".tmp", ec);
+}
+
+// Fill a task manager with `size` tasks, every third one completed
+static void populate(TaskManager& manager, size_t size) {
+    constexpr size_t batch_size = 65536;
+    for (size_t done = 0; done < size; done += batch_size) {
+        manager.begin_batch();
+        for (size_t i = done; i < std::min(size, done + batch_size); i++) {
+            // Mix of one-line and wrapped titles, like a real list
+            std::string title = "Benchmark task number " + std::to_string(i);
+            if (i % 5 == 0) {
+                title += " with a longer description that wraps onto a second line in the task panels";
+            }
+            manager.add_task(title);
+        }
+        manager.commit_batch();
+    }
+
+    std::vector<TaskId> to_complete;
+    size_t index = 0;
+    for (const Task& task : manager.ordered_view()) {
+        if (index++ % 3 == 0) {
+            to_complete.push_back(task.id);
+        }
+    }
+    manager.begin_batch();
+    for (const TaskId& id : to_complete) {
+        manager.toggle_task_status(id);
+    }
+    manager.commit_batch();
+}
+
+// Queue this frame's simulated input
+static void feed_input(Scenario scenario, size_t frame) {
+    ImGuiIO& io = ImGui::GetIO();
+    float wheel = (frame / 300) % 2 == 0 ? -1.0f : 1.0f;  // Scroll down, then back up
+
+    switch (scenario) {
+        case Scenario::Idle:
+            break;
+        case Scenario::Scroll:
+            io.AddMousePosEvent(display_size.x * 0.5f, display_size.y * 0.5f);  // Center panel
+            io.AddMouseWheelEvent(0.0f, wheel);
+            break;
+        case Scenario::Modal:
+            io.AddMousePosEvent(display_size.x * 0.5f - 180.0f, display_size.y * 0.5f);  // Modal's left column
+            io.AddMouseWheelEvent(0.0f, wheel);
+            break;
+    }
+}
+
+// Create an ImGui context driven by the null backend
+static void create_headless_context() {
+    ImGui::SetAllocatorFunctions(imgui_alloc, imgui_free);
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = nullptr;  // Same settings as the application
+    ImGui::StyleColorsDark();
+    ImGui_ImplNull_Init(display_size);
+}
+
+// Destroy the context made by create_headless_context()
+static void destroy_headless_context() {
+    ImGui_ImplNull_Shutdown();
+    ImGui::DestroyContext();
+}
+
+// Build and "render" one application frame
+static void step_frame(TaskManager& manager, TaskViewModel& view_model, AppState& state) {
+    FrameProfiler::instance().begin_frame();
+    ImGui_ImplNull_NewFrame();
+    ImGui::NewFrame();
+    DrawMainWindow(manager, view_model, state, display_size);
+    ImGui::Render();
+    ImGui_ImplNull_RenderDrawData(ImGui::GetDrawData());
+    FrameProfiler::instance().end_frame();
+}
+
+// Step warm-up and measured frames of one scenario
+static FrameStats run_frames(TaskManager& manager, Scenario scenario, size_t frames, bool profiler) {
+    create_headless_context();
+
+    TaskViewModel view_model;
+    AppState state;
+    state.show_mark_task_modal = scenario == Scenario::Modal;
+    state.profiler_window.open = profiler;
+
+    FrameStats stats;
+    stats.cpu_us.reserve(frames);
+    int texture_updates_before = 0;
+
+    // The profiler window grows until its frame history is full
+    const size_t warmup = profiler ? std::max(warmup_frames, FrameProfiler::history_size) : warmup_frames;
+
+    for (size_t frame = 0; frame < warmup + frames; frame++) {
+        bool measured = frame >= warmup;
+        if (frame == warmup) {
+            texture_updates_before = ImGui_ImplNull_GetStats().texture_updates;
+        }
+        feed_input(scenario, frame);
+
+        size_t heap_before = g_heap_allocations.load(std::memory_order_relaxed);
+        size_t imgui_before = g_imgui_allocations;
+        size_t imgui_bytes_before = g_imgui_bytes;
+        auto start = bench_clock::now();
+
+        step_frame(manager, view_model, state);
+
+        double elapsed_us = std::chrono::duration<double, std::micro>(bench_clock::now() - start).count();
+        if (!measured) {
+            continue;
+        }
+
+        size_t heap = g_heap_allocations.load(std::memory_order_relaxed) - heap_before;
+        const ImDrawData* draw_data = ImGui::GetDrawData();
+        stats.cpu_us.push_back(elapsed_us);
+        stats.vertices += draw_data->TotalVtxCount;
+        stats.indices += draw_data->TotalIdxCount;
+        stats.draw_lists += draw_data->CmdListsCount;
+        stats.imgui_allocations += static_cast<double>(g_imgui_allocations - imgui_before);
+        stats.imgui_bytes += static_cast<double>(g_imgui_bytes - imgui_bytes_before);
+        stats.heap_allocations += static_cast<double>(heap);
+        stats.max_heap_allocations = std::max(stats.max_heap_allocations, heap);
+    }
+    stats.texture_updates = ImGui_ImplNull_GetStats().texture_updates - texture_updates_before;
+
+    destroy_headless_context();
+
+    double count = static_cast<double>(std::max<size_t>(frames, 1));
+    stats.vertices /= count;
+    stats.indices /= count;
+    stats.draw_lists /= count;
+    stats.imgui_allocations /= count;
+    stats.imgui_bytes /= count;
+    stats.heap_allocations /= count;
+    std::sort(stats.cpu_us.begin(), stats.cpu_us.end());
+    return stats;
+}
+
+// CPU cost of an untouched window over a stretch of wall time
+struct IdleStats {
+    double cpu_ms_per_s = 0.0;      // Process CPU time per wall-clock second
+    uint64_t frames = 0;            // Frames built
+    uint64_t wakeups = 0;           // Wake-ups without a frame (on-demand loop only)
+};
+
+// Run the main loop with no input for `seconds`, either rendering every
+// vsync (the old loop) or on demand with RenderScheduler. Without a window,
+// SwapBuffers is emulated by sleeping to the next 60 Hz tick and
+// glfwWaitEventsTimeout() by sleeping the whole timeout (no events arrive).
+static IdleStats run_idle(TaskManager& manager, bool on_demand, double seconds) {
+    create_headless_context();
+
+    TaskViewModel view_model;
+    AppState state;
+    RenderScheduler scheduler;
+    IdleStats stats;
+
+    // Settle first (row cache, font atlas, the frames scheduled after the last input)
+    scheduler.check_generation(manager.get_generation());
+    for (size_t frame = 0; frame < warmup_frames || (on_demand && scheduler.should_render()); frame++) {
+        step_frame(manager, view_model, state);
+        scheduler.on_frame_rendered();
+    }
+
+    const auto vsync_interval = std::chrono::microseconds(16667);
+    auto start = bench_clock::now();
+    auto next_vsync = start;
+    std::clock_t cpu_start = std::clock();
+
+    while (std::chrono::duration<double>(bench_clock::now() - start).count() < seconds) {
+        if (on_demand) {
+            if (!scheduler.should_render()) {
+                std::this_thread::sleep_for(std::chrono::duration<double>(scheduler.get_wait_timeout()));
+            }
+            scheduler.check_generation(manager.get_generation());
+            if (!scheduler.should_render()) {
+                scheduler.on_idle_wakeup();
+                continue;
+            }
+        }
+
+        step_frame(manager, view_model, state);
+        stats.frames++;
+        scheduler.on_frame_rendered();
+        scheduler.set_continuous(NeedsContinuousRendering(state));
+
+        // Vsync: wait for the next refresh
+        next_vsync += vsync_interval;
+        if (next_vsync < bench_clock::now()) {
+            next_vsync = bench_clock::now();
+        }
+        std::this_thread::sleep_until(next_vsync);
+    }
+
+    double cpu_ms = 1000.0 * static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+    double wall_s = std::chrono::duration<double>(bench_clock::now() - start).count();
+    stats.cpu_ms_per_s = cpu_ms / wall_s;
+    stats.wakeups = scheduler.get_idle_wakeups();
+
+    destroy_headless_context();
+    return stats;
+}
+
+// Print one idle comparison row
+static void print_idle_row(size_t tasks, const char* loop, const IdleStats& stats, double seconds) {
+    std::cout << std::left << std::setw(10) << tasks << std::setw(12) << loop << std::right << std::fixed
+              << std::setprecision(3) << std::setw(14) << stats.cpu_ms_per_s
+              << std::setw(11) << std::setprecision(2) << stats.cpu_ms_per_s / 10.0
+              << std::setw(12) << std::setprecision(1) << static_cast<double>(stats.frames) / seconds
+              << std::setw(10) << stats.wakeups << std::endl;
+}
+
+// Compare idle CPU of the continuous and on-demand loops for one task count
+static void run_idle_size(const BenchOptions& options, size_t size) {
+    const std::filesystem::path path = options.dir / ("frame_bench_idle_" + std::to_string(size) + ".json");
+    remove_data_files(path);
+    {
+        TaskManager manager(path.string(), PersistenceMode::Snapshot);
+        manager.set_save_debounce(std::chrono::hours(1));
+        populate(manager, size);
+
+        print_idle_row(size, "every vsync", run_idle(manager, false, options.idle_seconds), options.idle_seconds);
+        print_idle_row(size, "on demand", run_idle(manager, true, options.idle_seconds), options.idle_seconds);
+    }
+    remove_data_files(path);
+}
+
+// Print the column headers
+static void print_header() {
+    std::cout << std::left << std::setw(10) << "tasks" << std::setw(9) << "scenario" << std::right
+              << std::setw(9) << "p50 us" << std::setw(9) << "p90 us" << std::setw(9) << "p99 us"
+              << std::setw(10) << "max us" << std::setw(9) << "vtx" << std::setw(9) << "idx"
+              << std::setw(7) << "lists" << std::setw(11) << "imgui a/f" << std::setw(11) << "imgui B/f"
+              << std::setw(10) << "heap a/f" << std::setw(10) << "heap max" << std::setw(8) << "tex up"
+              << std::endl;
+}
+
+// Print one result row
+static void print_row(size_t tasks, Scenario scenario, const FrameStats& stats) {
+    std::cout << std::left << std::setw(10) << tasks << std::setw(9) << scenario_name(scenario) << std::right
+              << std::fixed << std::setprecision(1)
+              << std::setw(9) << percentile(stats.cpu_us, 0.50) << std::setw(9) << percentile(stats.cpu_us, 0.90)
+              << std::setw(9) << percentile(stats.cpu_us, 0.99)
+              << std::setw(10) << (stats.cpu_us.empty() ? 0.0 : stats.cpu_us.back())
+              << std::setprecision(0) << std::setw(9) << stats.vertices << std::setw(9) << stats.indices
+              << std::setw(7) << stats.draw_lists << std::setprecision(2) << std::setw(11) << stats.imgui_allocations
+              << std::setprecision(0) << std::setw(11) << stats.imgui_bytes
+              << std::setprecision(2) << std::setw(10) << stats.heap_allocations
+              << std::setw(10) << stats.max_heap_allocations << std::setw(8) << stats.texture_updates << std::endl;
+}
+
+// Run every scenario for one task count
+// Returns false if --assert-zero-alloc is set and a measured frame allocated
+static bool run_size(const BenchOptions& options, size_t size) {
+    bool allocation_free = true;
+    const std::filesystem::path path = options.dir / ("frame_bench_" + std::to_string(size) + ".json");
+    remove_data_files(path);
+    {
+        TaskManager manager(path.string(), PersistenceMode::Snapshot);
+        manager.set_save_debounce(std::chrono::hours(1));  // Keep the background writer out of the timings
+
+        // Only the frames go into the trace
+        bool tracing = TraceRecorder::instance().is_capturing();
+        TraceRecorder::instance().stop_capture();
+        populate(manager, size);
+        if (tracing) {
+            TraceRecorder::instance().resume_capture();
+        }
+
+        for (Scenario scenario : options.scenarios) {
+            FrameStats stats = run_frames(manager, scenario, options.frames, options.profiler);
+            print_row(size, scenario, stats);
+            manager.clear_selection();  // The modal scenario leaves its selection state behind
+
+            if (options.assert_zero_alloc && (stats.max_heap_allocations > 0 || stats.imgui_allocations > 0.0)) {
+                std::cerr << "Error: " << scenario_name(scenario) << " frames with " << size
+                          << " tasks allocate in steady state" << std::endl;
+                allocation_free = false;
+            }
+        }
+    }
+    remove_data_files(path);
+    return allocation_free;
+}
+
+// Parse a comma-separated list of sizes
+static bool parse_sizes(const std::string& text, std::vector<size_t>& sizes) {
+    sizes.clear();
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        try {
+            sizes.push_back(static_cast<size_t>(std::stoull(item)));
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+    return !sizes.empty();
+}
+
+// Parse command line arguments
+static bool parse_options(int argc, char** argv, BenchOptions& options) {
+    options.dir = std::filesystem::temp_directory_path() / "frame_bench";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--sizes" && has_value) {
+            if (!parse_sizes(argv[++i], options.sizes)) {
+                std::cerr << "Error: Invalid --sizes list" << std::endl;
+                return false;
+            }
+        } else if (arg == "--frames" && has_value) {
+            options.frames = static_cast<size_t>(std::max(1LL, std::atoll(argv[++i])));
+        } else if (arg == "--scenario" && has_value) {
+            std::string scenario = argv[++i];
+            if (scenario == "idle") {
+                options.scenarios = {Scenario::Idle};
+            } else if (scenario == "scroll") {
+                options.scenarios = {Scenario::Scroll};
+            } else if (scenario == "modal") {
+                options.scenarios = {Scenario::Modal};
+            } else if (scenario != "all") {
+                std::cerr << "Error: --scenario must be idle, scroll, modal or all" << std::endl;
+                return false;
+            }
+        } else if (arg == "--idle-seconds" && has_value) {
+            options.idle_seconds = std::max(0.0, std::atof(argv[++i]));
+        } else if (arg == "--profiler") {
+            options.profiler = true;
+        } else if (arg == "--assert-zero-alloc") {
+            options.assert_zero_alloc = true;
+        } else if (arg == "--trace" && has_value) {
+            options.trace_path = argv[++i];
+        } else if (arg == "--dir" && has_value) {
+            options.dir = argv[++i];
+        } else {
+            std::cerr << "Usage: frame_bench [--sizes 0,1000,...] [--frames N] "
+                         "[--scenario idle|scroll|modal|all] [--profiler] [--idle-seconds S] [--assert-zero-alloc] "
+                         "[--trace FILE] [--dir DIR]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Stop the trace capture (if any) and write it
+static bool write_trace(const BenchOptions& options) {
+    if (options.trace_path.empty()) {
+        return true;
+    }
+
+    TraceRecorder& recorder = TraceRecorder::instance();
+    recorder.stop_capture();
+    if (!recorder.write_chrome_trace(options.trace_path)) {
+        return false;
+    }
+    std::cout << "Trace: " << recorder.get_event_count() << " events (" << recorder.get_dropped_count()
+              << " dropped) written to " << options.trace_path << std::endl;
+    return true;
+}
+
+// Benchmark entry point
+int main(int argc, char** argv) {
+    g_count_heap_allocations = true;  // This thread builds the frames
+    BenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        return 1;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(options.dir, ec);
+    if (ec) {
+        std::cerr << "Error: Cannot create scratch directory " << options.dir << ": " << ec.message() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Headless frame benchmark, " << display_size.x << "x" << display_size.y << ", "
+              << options.frames << " frames per run after "
+              << (options.profiler ? std::max(warmup_frames, FrameProfiler::history_size) : warmup_frames) << " warm-up frames"
+              << (options.profiler ? ", profiler window open" : "") << std::endl;
+    std::cout << "a/f = allocations per frame, B/f = bytes per frame" << std::endl;
+    print_header();
+
+    if (!options.trace_path.empty()) {
+        TraceRecorder::instance().set_thread_name("Benchmark");
+        TraceRecorder::instance().start_capture();
+    }
+
+    bool allocation_free = true;
+    for (size_t size : options.sizes) {
+        allocation_free = run_size(options, size) && allocation_free;
+    }
+
+    if (options.idle_seconds > 0.0) {
+        std::cout << std::endl << "Idle window, no input, " << options.idle_seconds
+                  << " s per loop (GPU and driver time not included)" << std::endl;
+        std::cout << std::left << std::setw(10) << "tasks" << std::setw(12) << "loop" << std::right
+                  << std::setw(14) << "CPU ms/s" << std::setw(11) << "CPU %" << std::setw(12) << "frames/s"
+                  << std::setw(10) << "wakeups" << std::endl;
+        for (size_t size : options.sizes) {
+            run_idle_size(options, size);
+        }
+    }
+    bool trace_written = write_trace(options);
+    return allocation_free && trace_written ? 0 : 1;
+}
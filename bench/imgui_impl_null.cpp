@@ -0,0 +1,85 @@
+#include <cstdint>
+#include "imgui_impl_null.h"
+
+// Backend state (one context at a time)
+static ImVec2 g_display_size;                   // Size reported as the display
+static float g_delta_time = 1.0f / 60.0f;       // Time step reported for every frame
+static intptr_t g_next_texture_id = 1;          // Fake texture handles (0 means invalid)
+static ImGuiNullRendererStats g_stats;
+
+// Mark a texture as destroyed
+static void destroy_texture(ImTextureData* tex) {
+    tex->SetTexID(ImTextureID_Invalid);
+    tex->SetStatus(ImTextureStatus_Destroyed);
+}
+
+// Handle one texture request the way a GPU renderer would, minus the upload
+static void update_texture(ImTextureData* tex) {
+    if (tex->Status == ImTextureStatus_WantCreate) {
+        tex->SetTexID(static_cast<ImTextureID>(g_next_texture_id++));
+        tex->SetStatus(ImTextureStatus_OK);
+        g_stats.textures_created++;
+        g_stats.pixels_uploaded += static_cast<size_t>(tex->Width) * static_cast<size_t>(tex->Height);
+    } else if (tex->Status == ImTextureStatus_WantUpdates) {
+        for (const ImTextureRect& rect : tex->Updates) {
+            g_stats.pixels_uploaded += static_cast<size_t>(rect.w) * static_cast<size_t>(rect.h);
+        }
+        tex->SetStatus(ImTextureStatus_OK);
+        g_stats.texture_updates++;
+    } else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0) {
+        destroy_texture(tex);
+    }
+}
+
+// Set up the backend for the current context
+bool ImGui_ImplNull_Init(const ImVec2& display_size, float delta_time) {
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendPlatformName = "imgui_impl_null";
+    io.BackendRendererName = "imgui_impl_null";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;  // Font atlas grows on demand, like the OpenGL3 backend
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+    g_display_size = display_size;
+    g_delta_time = delta_time;
+    g_stats = ImGuiNullRendererStats();
+    return true;
+}
+
+// Release backend textures
+void ImGui_ImplNull_Shutdown() {
+    for (ImTextureData* tex : ImGui::GetPlatformIO().Textures) {
+        if (tex->RefCount == 1) {
+            destroy_texture(tex);
+        }
+    }
+
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendPlatformName = nullptr;
+    io.BackendRendererName = nullptr;
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasVtxOffset);
+}
+
+// Apply the display size and frame time
+void ImGui_ImplNull_NewFrame() {
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = g_display_size;
+    io.DisplayFramebufferScale = ImVec2(1.0f, 1.0f);
+    io.DeltaTime = g_delta_time;
+}
+
+// Complete the frame's texture requests
+void ImGui_ImplNull_RenderDrawData(ImDrawData* draw_data) {
+    if (draw_data->Textures == nullptr) {
+        return;
+    }
+    for (ImTextureData* tex : *draw_data->Textures) {
+        if (tex->Status != ImTextureStatus_OK) {
+            update_texture(tex);
+        }
+    }
+}
+
+// Texture work requested since Init()
+const ImGuiNullRendererStats& ImGui_ImplNull_GetStats() {
+    return g_stats;
+}
@@ -0,0 +1,43 @@
+#ifndef IMGUI_IMPL_NULL_H
+#define IMGUI_IMPL_NULL_H
+
+#include "imgui.h"
+
+// Headless platform + renderer backend for Dear ImGui
+//
+// Provides a fixed display size and frame time instead of a window, and
+// accepts texture requests (the font atlas is still rasterized on the CPU)
+// without uploading anything, so UI code can be stepped frame by frame on
+// a machine with no display or GPU.
+//
+// Usage:
+//     ImGui::CreateContext();
+//     ImGui_ImplNull_Init(ImVec2(1200, 800));
+//     ImGui_ImplNull_NewFrame();  ImGui::NewFrame();  ...build UI...
+//     ImGui::Render();  ImGui_ImplNull_RenderDrawData(ImGui::GetDrawData());
+//     ImGui_ImplNull_Shutdown();
+//     ImGui::DestroyContext();
+
+// Counters of the work a real renderer would have done
+struct ImGuiNullRendererStats {
+    int textures_created = 0;       // Texture create requests (font atlas pages)
+    int texture_updates = 0;        // Partial texture updates (new glyphs)
+    size_t pixels_uploaded = 0;     // Pixels a GPU backend would have uploaded
+};
+
+// Set up the backend for the current context
+bool ImGui_ImplNull_Init(const ImVec2& display_size, float delta_time = 1.0f / 60.0f);
+
+// Release backend textures (call before ImGui::DestroyContext())
+void ImGui_ImplNull_Shutdown();
+
+// Apply the display size and frame time (call before ImGui::NewFrame())
+void ImGui_ImplNull_NewFrame();
+
+// Complete the frame's texture requests without drawing anything
+void ImGui_ImplNull_RenderDrawData(ImDrawData* draw_data);
+
+// Texture work requested since Init()
+const ImGuiNullRendererStats& ImGui_ImplNull_GetStats();
+
+#endif
@@ -0,0 +1,193 @@
+// Micro-benchmark for the selection list rows
+//
+// Draws the same rows with each widget inside a multi-select scope, like the
+// selection modals do:
+//   checkbox   PushID + Checkbox("##task") + SameLine + TextWrapped (three items per row)
+//   row        DrawTaskRowCheckbox measuring the wrapped text every frame
+//   cached     DrawTaskRowCheckbox with row heights kept from the first frame,
+//              as the selection modals do through TaskListLayout
+// Every row is submitted inside a window tall enough that none is clipped, and
+// only the row loop is timed. Prints CPU time and vertices per 10k rows.
+// Needs no display or GPU.
+//
+// Usage: row_bench [--rows 10000] [--repeats 50] [--width 360]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include "imgui.h"
+#include "imgui_impl_null.h"
+#include "task_row_widget.h"
+
+using bench_clock = std::chrono::steady_clock;
+
+// Command line settings
+struct BenchOptions {
+    size_t rows = 10000;        // Rows drawn per frame
+    size_t repeats = 50;        // Measured frames per widget
+    float width = 360.0f;       // Window width (one column of the selection modal)
+};
+
+// Row widget under test
+enum class RowPath {
+    Checkbox,   // ImGui::Checkbox + ImGui::TextWrapped
+    Row,        // DrawTaskRowCheckbox, text measured every frame
+    Cached      // DrawTaskRowCheckbox, heights from an earlier frame
+};
+
+// Measurements of one widget
+struct RowStats {
+    std::vector<double> cpu_us;     // Row loop time per frame
+    size_t vertices = 0;            // Vertices added by the row loop
+    size_t indices = 0;             // Indices added by the row loop
+};
+
+static const size_t warmup_frames = 5;      // Unmeasured frames (atlas build, window settling)
+static const float row_height_bound = 48.0f;    // More than a two-line row, so the window fits every row
+
+// Widget name for output
+static const char* path_name(RowPath path) {
+    switch (path) {
+        case RowPath::Checkbox: return "checkbox";
+        case RowPath::Row: return "row";
+        case RowPath::Cached: return "cached";
+    }
+    return "?";
+}
+
+// Labels as the modal formats them, a mix of one-line and wrapped titles
+static std::vector<std::string> make_labels(size_t rows) {
+    std::vector<std::string> labels(rows);
+    for (size_t i = 0; i < rows; i++) {
+        labels[i] = std::to_string(i + 1) + ". Benchmark task number " + std::to_string(i);
+        if (i % 5 == 0) {
+            labels[i] += " with a longer description that wraps onto a second line in the task panels";
+        }
+    }
+    return labels;
+}
+
+// Draw every row with one widget; returns the loop time in microseconds
+static double draw_rows(RowPath path, const std::vector<std::string>& labels, std::vector<float>& heights,
+                        RowStats& stats) {
+    ImGuiMultiSelectFlags flags = ImGuiMultiSelectFlags_NoAutoSelect | ImGuiMultiSelectFlags_NoAutoClear |
+                                  ImGuiMultiSelectFlags_BoxSelect1d;
+    ImGui::BeginMultiSelect(flags, -1, static_cast<int>(labels.size()));
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    int vertices_before = draw_list->VtxBuffer.Size;
+    int indices_before = draw_list->IdxBuffer.Size;
+    auto start = bench_clock::now();
+
+    for (size_t i = 0; i < labels.size(); i++) {
+        bool selected = i % 3 == 0;  // Some ticks to draw
+        ImGui::SetNextItemSelectionUserData(static_cast<ImGuiSelectionUserData>(i));
+        if (path == RowPath::Checkbox) {
+            ImGui::PushID(static_cast<int>(i * 0x9E3779B1u));  // Task id hash
+            ImGui::Checkbox("##task", &selected);
+            ImGui::PopID();
+            ImGui::SameLine();
+            ImGui::TextWrapped("%s", labels[i].c_str());
+        } else {
+            float* row_height = path == RowPath::Cached ? &heights[i] : NULL;
+            DrawTaskRowCheckbox(ImGui::GetID(static_cast<int>(i)), labels[i].c_str(), NULL, row_height, &selected);
+        }
+    }
+
+    double elapsed_us = std::chrono::duration<double, std::micro>(bench_clock::now() - start).count();
+    stats.vertices = static_cast<size_t>(draw_list->VtxBuffer.Size - vertices_before);
+    stats.indices = static_cast<size_t>(draw_list->IdxBuffer.Size - indices_before);
+
+    ImGui::EndMultiSelect();
+    return elapsed_us;
+}
+
+// Step warm-up and measured frames of one widget
+static RowStats run_path(RowPath path, const BenchOptions& options, const std::vector<std::string>& labels) {
+    const ImVec2 display_size(options.width, row_height_bound * static_cast<float>(options.rows));
+    ImGui::CreateContext();
+    ImGui::GetIO().IniFilename = nullptr;
+    ImGui::StyleColorsDark();
+    ImGui_ImplNull_Init(display_size);
+
+    RowStats stats;
+    stats.cpu_us.reserve(options.repeats);
+    std::vector<float> heights(labels.size(), 0.0f);  // Filled by the first (warm-up) frame
+    for (size_t frame = 0; frame < warmup_frames + options.repeats; frame++) {
+        ImGui_ImplNull_NewFrame();
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(display_size);
+        ImGui::Begin("Rows", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings);
+        double elapsed_us = draw_rows(path, labels, heights, stats);
+        ImGui::End();
+        ImGui::Render();
+        ImGui_ImplNull_RenderDrawData(ImGui::GetDrawData());
+        if (frame >= warmup_frames) {
+            stats.cpu_us.push_back(elapsed_us);
+        }
+    }
+
+    ImGui_ImplNull_Shutdown();
+    ImGui::DestroyContext();
+    std::sort(stats.cpu_us.begin(), stats.cpu_us.end());
+    return stats;
+}
+
+// Print one result row, scaled to 10k rows
+static void print_row(RowPath path, size_t rows, const RowStats& stats, double baseline_us) {
+    double scale = 10000.0 / static_cast<double>(rows);
+    double p50 = stats.cpu_us[stats.cpu_us.size() / 2] * scale;
+    double best = stats.cpu_us.front() * scale;
+    std::cout << std::left << std::setw(10) << path_name(path) << std::right << std::fixed << std::setprecision(1)
+              << std::setw(12) << p50 << std::setw(12) << best
+              << std::setprecision(0) << std::setw(12) << static_cast<double>(stats.vertices) * scale
+              << std::setw(12) << static_cast<double>(stats.indices) * scale
+              << std::setprecision(2) << std::setw(10) << (p50 > 0.0 ? baseline_us / p50 : 0.0) << "x" << std::endl;
+}
+
+// Parse command line arguments
+static bool parse_options(int argc, char** argv, BenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--rows" && has_value) {
+            options.rows = static_cast<size_t>(std::max(1LL, std::atoll(argv[++i])));
+        } else if (arg == "--repeats" && has_value) {
+            options.repeats = static_cast<size_t>(std::max(1LL, std::atoll(argv[++i])));
+        } else if (arg == "--width" && has_value) {
+            options.width = std::max(100.0f, static_cast<float>(std::atof(argv[++i])));
+        } else {
+            std::cerr << "Usage: row_bench [--rows N] [--repeats N] [--width PX]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Benchmark entry point
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        return 1;
+    }
+
+    std::vector<std::string> labels = make_labels(options.rows);
+    std::cout << "Selection list rows, " << options.rows << " rows per frame in a " << options.width
+              << " px column, " << options.repeats << " frames per widget, scaled to 10k rows" << std::endl;
+    std::cout << std::left << std::setw(10) << "widget" << std::right << std::setw(12) << "p50 us"
+              << std::setw(12) << "best us" << std::setw(12) << "vtx" << std::setw(12) << "idx"
+              << std::setw(11) << "speedup" << std::endl;
+
+    RowStats checkbox = run_path(RowPath::Checkbox, options, labels);
+    double baseline_us = checkbox.cpu_us[checkbox.cpu_us.size() / 2] * 10000.0 / static_cast<double>(options.rows);
+    print_row(RowPath::Checkbox, options.rows, checkbox, baseline_us);
+    print_row(RowPath::Row, options.rows, run_path(RowPath::Row, options, labels), baseline_us);
+    print_row(RowPath::Cached, options.rows, run_path(RowPath::Cached, options, labels), baseline_us);
+    return 0;
+}
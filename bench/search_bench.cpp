@@ -0,0 +1,239 @@
+// Benchmark for the unindexed title scan
+//
+// Fills a TaskManager with titles drawn from a mix like a real task list
+// (short errands, longer notes, numbers, some accented and non-Latin UTF-8
+// words), then scans every title for each query with:
+//   find           std::string::find on each title (case-sensitive, no folding)
+//   lower+find     lowercased copy of each title, then find (case-insensitive)
+//   title/<kernel> contains_folded() on each title
+//   column/<kernel>
+//                  TaskManager::scan_titles(): the kernel run over the title column
+// for the scalar, sse2 and avx2 kernels this CPU supports. Prints the scan rate
+// over the title bytes and the number of matching tasks; the kernels must find
+// the same tasks as lower+find. Needs no display.
+//
+// Usage: search_bench [--tasks 1000000] [--repeats 10] [--dir <scratch directory>]
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <cstdlib>
+#include "task_manager.h"
+#include "text_search.h"
+
+using bench_clock = std::chrono::steady_clock;
+
+// Command line settings
+struct BenchOptions {
+    size_t tasks = 1000000;         // Titles to scan
+    size_t repeats = 10;            // Timed scans per query and method
+    std::filesystem::path dir;      // Scratch directory for the data file
+};
+
+// Scan result of one method
+struct ScanStats {
+    double p50_ms = 0.0;        // Median scan time
+    size_t matches = 0;         // Matching tasks
+};
+
+// Words of the generated titles (a few with capitals, digits or UTF-8)
+static const char* const common_words[] = {
+    "Buy", "milk", "call", "mom", "email", "the", "team", "about", "report", "review", "budget", "fix",
+    "bug", "in", "login", "page", "update", "docs", "for", "release", "plan", "trip", "to", "book",
+    "flights", "dentist", "appointment", "pay", "rent", "water", "plants", "clean", "kitchen", "prepare",
+    "slides", "meeting", "with", "Alice", "Bob", "quarterly", "send", "invoice", "client", "renew",
+    "passport", "order", "groceries", "walk", "dog", "read", "chapter", "of", "and", "check", "PR",
+    "deploy", "server", "backup", "photos", "write", "blog", "post", "on", "Friday", "Monday", "API"};
+static const char* const utf8_words[] = {
+    "café", "Müller", "naïve", "résumé", "Zürich", "São Paulo", "日本語", "レポート", "Ærø", "niño", "crème brûlée"};
+
+// Generate titles: mostly 1-4 words, some notes up to 25 words
+static std::vector<std::string> make_titles(size_t count) {
+    std::mt19937_64 rng(42);
+    const size_t common_count = sizeof(common_words) / sizeof(common_words[0]);
+    const size_t utf8_count = sizeof(utf8_words) / sizeof(utf8_words[0]);
+
+    std::vector<std::string> titles(count);
+    for (std::string& title : titles) {
+        size_t roll = rng() % 100;
+        size_t words = roll < 60 ? 1 + rng() % 4 : roll < 90 ? 5 + rng() % 6 : 11 + rng() % 15;
+        for (size_t w = 0; w < words; w++) {
+            if (w > 0) {
+                title += ' ';
+            }
+            size_t kind = rng() % 100;
+            if (kind < 5) {
+                title += utf8_words[rng() % utf8_count];
+            } else if (kind < 10) {
+                title += std::to_string(rng() % 10000);
+            } else {
+                title += common_words[rng() % common_count];
+            }
+        }
+    }
+    return titles;
+}
+
+// Median of the scan times of `repeats` runs
+static double time_scans(size_t repeats, const std::function<void()>& scan) {
+    std::vector<double> times_ms;
+    times_ms.reserve(repeats);
+    for (size_t i = 0; i < repeats; i++) {
+        auto start = bench_clock::now();
+        scan();
+        times_ms.push_back(std::chrono::duration<double, std::milli>(bench_clock::now() - start).count());
+    }
+    std::sort(times_ms.begin(), times_ms.end());
+    return times_ms[times_ms.size() / 2];
+}
+
+// Print one result row
+static void print_row(const std::string& query, const std::string& method, const ScanStats& stats, double title_bytes,
+                      double baseline_ms) {
+    double gb_per_s = stats.p50_ms > 0.0 ? title_bytes / (stats.p50_ms * 1e6) : 0.0;
+    std::cout << std::left << std::setw(26) << ("\"" + query + "\"") << std::setw(16) << method << std::right
+              << std::fixed << std::setprecision(2) << std::setw(10) << stats.p50_ms << std::setw(10) << gb_per_s
+              << std::setw(10) << stats.matches << std::setw(10)
+              << (stats.p50_ms > 0.0 ? baseline_ms / stats.p50_ms : 0.0) << "x" << std::endl;
+}
+
+// Remove a data file and its journal
+static void remove_data_files(const std::filesystem::path& path) {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    std::filesystem::remove(path.string() + ".log", ec);
+    std::filesystem::remove(path.string() + ".tmp", ec);
+}
+
+// Scan every title for each query with every method
+// Returns false if a kernel disagrees with lower+find
+static bool run_queries(const BenchOptions& options, const TaskManager& manager) {
+    const std::vector<std::string> queries = {"milk", "Report", "zebra", "q", "2024", "café", "日本",
+                                              "quarterly budget review"};
+    const TaskManager::TaskView view = manager.all_tasks_view();
+
+    double title_bytes = 0.0;
+    for (const Task& task : view) {
+        title_bytes += static_cast<double>(task.title.size());
+    }
+    std::cout << "Title scan over " << view.size() << " tasks, " << std::fixed << std::setprecision(1)
+              << title_bytes / 1e6 << " MB of titles (" << title_bytes / static_cast<double>(view.size())
+              << " bytes on average), median of " << options.repeats << " scans" << std::endl;
+    std::cout << std::left << std::setw(26) << "query" << std::setw(16) << "method" << std::right << std::setw(10)
+              << "p50 ms" << std::setw(10) << "GB/s" << std::setw(10) << "matches" << std::setw(11) << "vs find"
+              << std::endl;
+
+    bool agree = true;
+    std::vector<TaskHandle> handles;
+    const TextSearchKernel best = get_best_text_search_kernel();
+    for (const std::string& query : queries) {
+        ScanStats find;
+        find.p50_ms = time_scans(options.repeats, [&] {
+            find.matches = 0;
+            for (const Task& task : view) {
+                find.matches += task.title.find(query) != std::string::npos;
+            }
+        });
+        print_row(query, "find", find, title_bytes, find.p50_ms);
+
+        ScanStats lower;
+        const std::string folded = fold_ascii_case(query);
+        lower.p50_ms = time_scans(options.repeats, [&] {
+            lower.matches = 0;
+            for (const Task& task : view) {
+                lower.matches += fold_ascii_case(task.title).find(folded) != std::string::npos;
+            }
+        });
+        print_row(query, "lower+find", lower, title_bytes, find.p50_ms);
+
+        for (int use_column = 0; use_column < 2; use_column++) {
+            for (int kernel = 0; kernel <= static_cast<int>(best); kernel++) {
+                set_text_search_kernel(static_cast<TextSearchKernel>(kernel));
+                std::string method = std::string(use_column ? "column/" : "title/") +
+                                     get_text_search_kernel_name(static_cast<TextSearchKernel>(kernel));
+                ScanStats scan;
+                scan.p50_ms = time_scans(options.repeats, [&] {
+                    scan.matches = 0;
+                    if (use_column) {
+                        manager.scan_titles(query, handles);
+                        scan.matches = handles.size();
+                    } else {
+                        for (const Task& task : view) {
+                            scan.matches += contains_folded(task.title, folded);
+                        }
+                    }
+                });
+                print_row(query, method, scan, title_bytes, find.p50_ms);
+                if (scan.matches != lower.matches) {
+                    std::cerr << "Error: " << method << " found " << scan.matches << " tasks, lower+find "
+                              << lower.matches << std::endl;
+                    agree = false;
+                }
+            }
+        }
+        set_text_search_kernel(best);
+    }
+    return agree;
+}
+
+// Parse command line arguments
+static bool parse_options(int argc, char** argv, BenchOptions& options) {
+    options.dir = std::filesystem::temp_directory_path() / "task_bench";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--tasks" && has_value) {
+            options.tasks = static_cast<size_t>(std::max(1LL, std::atoll(argv[++i])));
+        } else if (arg == "--repeats" && has_value) {
+            options.repeats = static_cast<size_t>(std::max(1LL, std::atoll(argv[++i])));
+        } else if (arg == "--dir" && has_value) {
+            options.dir = argv[++i];
+        } else {
+            std::cerr << "Usage: search_bench [--tasks N] [--repeats N] [--dir DIR]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Benchmark entry point
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        return 1;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(options.dir, ec);
+    if (ec) {
+        std::cerr << "Error: Cannot create scratch directory " << options.dir << ": " << ec.message() << std::endl;
+        return 1;
+    }
+
+    const std::filesystem::path path = options.dir / "search_bench.json";
+    remove_data_files(path);
+    bool agree = true;
+    {
+        TaskManager manager(path.string(), PersistenceMode::Snapshot);
+        manager.set_save_debounce(std::chrono::hours(1));  // Keep the background writer out of the timings
+
+        std::vector<std::string> titles = make_titles(options.tasks);
+        manager.begin_batch();
+        for (const std::string& title : titles) {
+            manager.add_task(title);
+        }
+        manager.commit_batch();
+
+        agree = run_queries(options, manager);
+    }
+    remove_data_files(path);
+    return agree ? 0 : 1;
+}
@@ -0,0 +1,424 @@
+// Benchmark for the task core (TaskManager and persistence)
+//
+// Runs add/delete/toggle/query/save/load at several task counts and prints
+// throughput and latency percentiles per operation, plus the persistence
+// counters (snapshot writes, queue depth). Needs no display, so it
+// runs on any machine that can build taskcore.
+//
+// Usage: task_bench [--sizes 1000,10000,100000,1000000] [--samples 10000]
+//                   [--mode journal|snapshot|both] [--trace <trace.json>] [--dir <scratch directory>]
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include "task_manager.h"
+#include "trace_recorder.h"
+
+using bench_clock = std::chrono::steady_clock;
+
+// Command line settings
+struct BenchOptions {
+    std::vector<size_t> sizes = {1000, 10000, 100000, 1000000};   // Task counts to test
+    size_t samples = 10000;                 // Timed operations per mutation/lookup benchmark
+    bool journal = true;                    // Run with PersistenceMode::Journal
+    bool snapshot = true;                   // Run with PersistenceMode::Snapshot
+    std::string trace_path;                 // Chrome trace of the whole run (empty = no capture)
+    std::filesystem::path dir;              // Scratch directory for data files
+};
+
+// Throughput and latency distribution of one operation
+struct BenchResult {
+    size_t count = 0;           // Operations measured
+    double total_s = 0.0;       // Wall time of all operations
+    double p50_us = 0.0;        // Latency percentiles (microseconds)
+    double p90_us = 0.0;
+    double p99_us = 0.0;
+    double max_us = 0.0;
+    bool has_latency = false;   // False for bulk measurements (throughput only)
+};
+
+// Elapsed seconds since `start`
+static double seconds_since(bench_clock::time_point start) {
+    return std::chrono::duration<double>(bench_clock::now() - start).count();
+}
+
+// Value at quantile `q` of sorted samples
+static double percentile(const std::vector<double>& sorted, double q) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(q * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+// Microseconds since `start`
+static double micros_since(bench_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(bench_clock::now() - start).count();
+}
+
+// Build a result from per-operation latencies
+static BenchResult summarize(std::vector<double>& latencies_us, double total_s) {
+    BenchResult result;
+    result.count = latencies_us.size();
+    result.total_s = total_s;
+    result.has_latency = true;
+
+    std::sort(latencies_us.begin(), latencies_us.end());
+    result.p50_us = percentile(latencies_us, 0.50);
+    result.p90_us = percentile(latencies_us, 0.90);
+    result.p99_us = percentile(latencies_us, 0.99);
+    result.max_us = latencies_us.empty() ? 0.0 : latencies_us.back();
+    return result;
+}
+
+// Time each call of `operation(i)` individually
+static BenchResult time_each(size_t count, const std::function<void(size_t)>& operation) {
+    std::vector<double> latencies_us;
+    latencies_us.reserve(count);
+
+    auto start = bench_clock::now();
+    for (size_t i = 0; i < count; i++) {
+        auto op_start = bench_clock::now();
+        operation(i);
+        latencies_us.push_back(micros_since(op_start));
+    }
+    return summarize(latencies_us, seconds_since(start));
+}
+
+// Time constructing a TaskManager from an existing data file
+// (the destructor's final save is not part of the measurement)
+static BenchResult time_load(const std::filesystem::path& path, PersistenceMode mode, size_t count) {
+    std::vector<double> latencies_us;
+    double total_s = 0.0;
+
+    for (size_t i = 0; i < count; i++) {
+        auto start = bench_clock::now();
+        auto loaded = std::make_unique<TaskManager>(path.string(), mode);
+        latencies_us.push_back(micros_since(start));
+        total_s += latencies_us.back() / 1e6;
+
+        loaded->set_save_debounce(std::chrono::hours(1));
+        loaded.reset();
+    }
+    return summarize(latencies_us, total_s);
+}
+
+// Time `count` operations performed by one call (throughput only)
+static BenchResult time_bulk(size_t count, const std::function<void()>& operation) {
+    auto start = bench_clock::now();
+    operation();
+
+    BenchResult result;
+    result.count = count;
+    result.total_s = seconds_since(start);
+    return result;
+}
+
+// Print the column headers
+static void print_header() {
+    std::cout << std::left << std::setw(10) << "tasks" << std::setw(10) << "mode" << std::setw(22) << "operation"
+              << std::right << std::setw(10) << "count" << std::setw(14) << "ops/s"
+              << std::setw(11) << "p50 us" << std::setw(11) << "p90 us" << std::setw(11) << "p99 us"
+              << std::setw(12) << "max us" << std::endl;
+}
+
+// Print one result row
+static void print_row(size_t tasks, const char* mode, const std::string& operation, const BenchResult& result) {
+    double ops_per_s = result.total_s > 0.0 ? static_cast<double>(result.count) / result.total_s : 0.0;
+
+    std::cout << std::left << std::setw(10) << tasks << std::setw(10) << mode << std::setw(22) << operation
+              << std::right << std::setw(10) << result.count << std::setw(14) << std::fixed << std::setprecision(0)
+              << ops_per_s << std::setprecision(2);
+    if (result.has_latency) {
+        std::cout << std::setw(11) << result.p50_us << std::setw(11) << result.p90_us << std::setw(11)
+                  << result.p99_us << std::setw(12) << result.max_us;
+    } else {
+        std::cout << std::setw(11) << "-" << std::setw(11) << "-" << std::setw(11) << "-" << std::setw(12) << "-";
+    }
+    std::cout << std::endl;
+}
+
+// Ids of every task, in id order
+static std::vector<TaskId> collect_ids(const TaskManager& manager) {
+    std::vector<TaskId> ids;
+    ids.reserve(manager.task_count());
+    for (const Task& task : manager.ordered_view()) {
+        ids.push_back(task.id);
+    }
+    return ids;
+}
+
+// Remove a data file and its journal
+static void remove_data_files(const std::filesystem::path& path) {
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    std::filesystem::remove(path.string() + ".log", ec);
+    std::filesystem::remove(path.string() + ".tmp", ec);
+}
+
+// Run every benchmark for one task count and persistence mode
+static void run_size(const BenchOptions& options, size_t size, PersistenceMode mode) {
+    const char* mode_name = mode == PersistenceMode::Journal ? "journal" : "snapshot";
+    const std::filesystem::path path = options.dir / ("bench_" + std::to_string(size) + ".json");
+    const size_t samples = std::min(options.samples, size);
+    std::mt19937_64 rng(size);
+
+    remove_data_files(path);
+    {
+        TaskManager manager(path.string(), mode);
+        manager.set_save_debounce(std::chrono::hours(1));  // Keep the background writer out of the timings
+
+        // Populate in import-sized batches
+        print_row(size, mode_name, "populate (batched)", time_bulk(size, [&] {
+            constexpr size_t batch_size = 65536;
+            for (size_t done = 0; done < size; done += batch_size) {
+                manager.begin_batch();
+                for (size_t i = done; i < std::min(size, done + batch_size); i++) {
+                    manager.add_task("Benchmark task number " + std::to_string(i));
+                }
+                manager.commit_batch();
+            }
+        }));
+
+        // Single mutations, each persisted on its own
+        print_row(size, mode_name, "add", time_each(samples, [&](size_t i) {
+            manager.add_task("Added task " + std::to_string(i));
+        }));
+
+        std::vector<TaskId> ids = collect_ids(manager);
+        std::shuffle(ids.begin(), ids.end(), rng);
+
+        print_row(size, mode_name, "toggle", time_each(samples, [&](size_t i) {
+            manager.toggle_task_status(ids[i]);
+        }));
+
+        // Lookups and queries
+        size_t found = 0;
+        print_row(size, mode_name, "find_task", time_each(samples, [&](size_t i) {
+            found += manager.find_task(ids[(i * 7919) % ids.size()]) != nullptr;
+        }));
+
+        const size_t scans = std::max<size_t>(3, std::min<size_t>(100, 10000000 / size));
+        size_t done_count = 0;
+        print_row(size, mode_name, "scan all_tasks_view", time_each(scans, [&](size_t) {
+            for (const Task& task : manager.all_tasks_view()) {
+                done_count += task.done;
+            }
+        }));
+        print_row(size, mode_name, "scan uncompleted_view", time_each(scans, [&](size_t) {
+            for (const Task& task : manager.uncompleted_view()) {
+                done_count += task.title.size();
+            }
+        }));
+
+        TaskManager::TaskView ordered = manager.ordered_view();
+        uint64_t since = uuid_v7_timestamp(ordered[ordered.size() - ordered.size() / 100 - 1].id);
+        print_row(size, mode_name, "created_since (1%)", time_each(scans, [&](size_t) {
+            for (const Task& task : manager.created_since_view(since)) {
+                done_count += task.done;
+            }
+        }));
+
+        print_row(size, mode_name, "copy uncompleted", time_each(scans, [&](size_t) {
+            done_count += manager.get_uncompleted_tasks().size();
+        }));
+
+        // Title search, as typed into the search fields (the first run merges queued index updates)
+        TitleSearchResult search;
+        const std::string selective = "number " + std::to_string(size / 2);
+        print_row(size, mode_name, "search selective", time_each(scans, [&](size_t) {
+            manager.search_titles(selective, search);
+            found += search.uncompleted_slots.size() + search.completed_slots.size();
+        }));
+        print_row(size, mode_name, "search no match", time_each(scans, [&](size_t) {
+            manager.search_titles("zebra", search);
+            found += search.uncompleted_slots.size() + search.completed_slots.size();
+        }));
+        print_row(size, mode_name, "search common", time_each(scans, [&](size_t) {
+            manager.search_titles("TASK", search);
+            found += search.uncompleted_slots.size() + search.completed_slots.size();
+        }));
+        print_row(size, mode_name, "search short (scan)", time_each(scans, [&](size_t) {
+            manager.search_titles("12", search);
+            found += search.uncompleted_slots.size() + search.completed_slots.size();
+        }));
+        std::cout << "  title index: " << std::fixed << std::setprecision(1)
+                  << static_cast<double>(manager.get_search_index_bytes()) / (1024.0 * 1024.0) << " MB, "
+                  << static_cast<double>(manager.get_search_index_bytes()) / static_cast<double>(manager.task_count())
+                  << " bytes per task" << std::endl;
+
+        // Selection, as used by the mark and delete modals
+        print_row(size, mode_name, "init_selection_states", time_each(scans, [&](size_t) {
+            manager.init_selection_states();
+        }));
+        print_row(size, mode_name, "toggle_task_selection", time_each(samples, [&](size_t i) {
+            manager.toggle_task_selection(ids[i]);
+        }));
+        print_row(size, mode_name, "has_selection", time_each(samples, [&](size_t) {
+            found += manager.has_selection();
+        }));
+        print_row(size, mode_name, "select_all", time_each(scans, [&](size_t) { manager.select_all(); }));
+        print_row(size, mode_name, "invert_selection", time_each(scans, [&](size_t) { manager.invert_selection(); }));
+        print_row(size, mode_name, "select_by_status", time_each(scans, [&](size_t) {
+            manager.clear_selection();
+            manager.select_by_status(true);
+        }));
+        manager.select_all();
+        print_row(size, mode_name, "get_selected_task_ids", time_each(scans, [&](size_t) {
+            found += manager.get_selected_task_ids().size();
+        }));
+        manager.clear_selection();
+
+        print_row(size, mode_name, "delete", time_each(samples, [&](size_t i) {
+            manager.delete_task(ids[i]);
+        }));
+
+        // Snapshot writes in every encoding
+        const size_t reps = size >= 1000000 ? 3 : 10;
+        manager.set_json_style(JsonStyle::Pretty);
+        print_row(size, mode_name, "save json pretty", time_each(reps, [&](size_t) { manager.save(); }));
+
+        manager.set_json_style(JsonStyle::Compact);
+        print_row(size, mode_name, "save json compact", time_each(reps, [&](size_t) { manager.save(); }));
+
+        manager.set_snapshot_format(SnapshotFormat::Binary);
+        print_row(size, mode_name, "save binary", time_each(reps, [&](size_t) { manager.save(); }));
+
+        // Counters of the persistence layer over every write above
+        const PersistenceStats stats = manager.get_persistence_stats();
+        std::cout << "  snapshot writes: " << stats.snapshots_written << " covering " << stats.mutations_coalesced
+                  << " mutations, queue depth " << stats.queue_depth << ", write ms last/mean/max " << std::fixed
+                  << std::setprecision(1) << stats.last_write_ms << "/"
+                  << (stats.snapshots_written > 0 ? stats.total_write_ms / static_cast<double>(stats.snapshots_written)
+                                                  : 0.0)
+                  << "/" << stats.max_write_ms << std::endl;
+
+        if (found + done_count == 0) {
+            std::cout << "(no tasks found)" << std::endl;  // Keeps the query loops from being optimized away
+        }
+    }
+
+    // Loads (the file is binary after the last save above)
+    print_row(size, mode_name, "load binary", time_load(path, mode, 3));
+
+    {
+        TaskManager converter(path.string(), mode);
+        converter.set_json_style(JsonStyle::Pretty);
+        converter.set_snapshot_format(SnapshotFormat::Json);
+    }
+    print_row(size, mode_name, "load json", time_load(path, mode, 3));
+
+    remove_data_files(path);
+}
+
+// Parse a comma-separated list of sizes
+static bool parse_sizes(const std::string& text, std::vector<size_t>& sizes) {
+    sizes.clear();
+    std::stringstream stream(text);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        try {
+            sizes.push_back(static_cast<size_t>(std::stoull(item)));
+        } catch (const std::exception&) {
+            return false;
+        }
+        if (sizes.back() == 0) {
+            return false;
+        }
+    }
+    return !sizes.empty();
+}
+
+// Parse command line arguments
+static bool parse_options(int argc, char** argv, BenchOptions& options) {
+    options.dir = std::filesystem::temp_directory_path() / "task_bench";
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+
+        if (arg == "--sizes" && has_value) {
+            if (!parse_sizes(argv[++i], options.sizes)) {
+                std::cerr << "Error: Invalid --sizes list" << std::endl;
+                return false;
+            }
+        } else if (arg == "--samples" && has_value) {
+            options.samples = static_cast<size_t>(std::max(1LL, std::atoll(argv[++i])));
+        } else if (arg == "--mode" && has_value) {
+            std::string mode = argv[++i];
+            options.journal = mode == "journal" || mode == "both";
+            options.snapshot = mode == "snapshot" || mode == "both";
+            if (!options.journal && !options.snapshot) {
+                std::cerr << "Error: --mode must be journal, snapshot or both" << std::endl;
+                return false;
+            }
+        } else if (arg == "--trace" && has_value) {
+            options.trace_path = argv[++i];
+        } else if (arg == "--dir" && has_value) {
+            options.dir = argv[++i];
+        } else {
+            std::cerr << "Usage: task_bench [--sizes 1000,10000,...] [--samples N] "
+                         "[--mode journal|snapshot|both] [--trace FILE] [--dir DIR]" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// Stop the trace capture (if any) and write it
+static bool write_trace(const BenchOptions& options) {
+    if (options.trace_path.empty()) {
+        return true;
+    }
+
+    TraceRecorder& recorder = TraceRecorder::instance();
+    recorder.stop_capture();
+    if (!recorder.write_chrome_trace(options.trace_path)) {
+        return false;
+    }
+    std::cout << "Trace: " << recorder.get_event_count() << " events (" << recorder.get_dropped_count()
+              << " dropped) written to " << options.trace_path << std::endl;
+    return true;
+}
+
+// Benchmark entry point
+int main(int argc, char** argv) {
+    BenchOptions options;
+    if (!parse_options(argc, argv, options)) {
+        return 1;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(options.dir, ec);
+    if (ec) {
+        std::cerr << "Error: Cannot create scratch directory " << options.dir << ": " << ec.message() << std::endl;
+        return 1;
+    }
+
+    std::cout << "Task core benchmark, data files in " << options.dir.string() << std::endl;
+    std::cout << "Background snapshot writes are deferred; save rows time the writes explicitly." << std::endl;
+    print_header();
+
+    if (!options.trace_path.empty()) {
+        TraceRecorder::instance().set_thread_name("Benchmark");
+        TraceRecorder::instance().start_capture();
+    }
+
+    for (size_t size : options.sizes) {
+        if (options.journal) {
+            run_size(options, size, PersistenceMode::Journal);
+        }
+        if (options.snapshot) {
+            run_size(options, size, PersistenceMode::Snapshot);
+        }
+    }
+    return write_trace(options) ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <cstdio>
+#include "frame_arena.h"
+
+// Create an arena with one block
+FrameArena::FrameArena(size_t initial_capacity)
+    : block(std::make_unique<char[]>(std::max<size_t>(initial_capacity, 64))),
+      capacity(std::max<size_t>(initial_capacity, 64))
+{
+}
+
+// Release everything allocated since the last reset
+void FrameArena::reset() {
+    peak_bytes = std::max(peak_bytes, frame_bytes);
+
+    if (!retired.empty()) {
+        // The frame did not fit: replace the chain with one block for the whole frame
+        retired.clear();
+        capacity = std::max(capacity, frame_bytes + frame_bytes / 2);
+        block = std::make_unique<char[]>(capacity);
+        growth_count++;
+    }
+
+    used = 0;
+    frame_bytes = 0;
+}
+
+// Start a new block that can hold at least `size` bytes
+void FrameArena::grow(size_t size) {
+    retired.push_back(std::move(block));  // Earlier allocations stay valid until reset()
+    capacity = std::max(capacity * 2, size);
+    block = std::make_unique<char[]>(capacity);
+    used = 0;
+}
+
+// Get `size` aligned bytes valid until reset()
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    size_t offset = (used + alignment - 1) & ~(alignment - 1);
+    if (offset + size > capacity) {
+        grow(size + alignment);
+        offset = 0;  // New blocks are aligned for any type
+    }
+
+    frame_bytes += offset - used + size;
+    used = offset + size;
+    return block.get() + offset;
+}
+
+// Format a string into the arena
+const char* FrameArena::format(const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    const char* text = format_v(fmt, args);
+    va_end(args);
+    return text;
+}
+
+// Format a string into the arena from a va_list
+const char* FrameArena::format_v(const char* fmt, va_list args) {
+    // Try the rest of the current block first; most labels fit
+    size_t available = capacity - used;
+    va_list copy;
+    va_copy(copy, args);
+    int length = std::vsnprintf(block.get() + used, available, fmt, copy);
+    va_end(copy);
+
+    if (length < 0) {
+        return "";  // Encoding error
+    }
+    if (static_cast<size_t>(length) < available) {
+        char* text = block.get() + used;
+        frame_bytes += static_cast<size_t>(length) + 1;
+        used += static_cast<size_t>(length) + 1;
+        return text;
+    }
+
+    // Too long for the current block: reserve the exact size and format again
+    char* text = static_cast<char*>(allocate(static_cast<size_t>(length) + 1, 1));
+    std::vsnprintf(text, static_cast<size_t>(length) + 1, fmt, args);
+    return text;
+}
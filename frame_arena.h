@@ -0,0 +1,55 @@
+#ifndef FRAME_ARENA_H
+#define FRAME_ARENA_H
+
+#include <cstdarg>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Linear allocator for data that lives for one frame (formatted labels, scratch arrays)
+//
+// Allocation bumps a pointer inside one block; reset() at the start of each
+// frame makes the whole block reusable. When a frame needs more than the
+// block holds, extra blocks are chained for the rest of that frame and
+// reset() replaces them with a single block large enough for it, so steady
+// state frames make no heap allocations.
+class FrameArena {
+private:
+    std::unique_ptr<char[]> block;              // Current block
+    size_t capacity = 0;                        // Size of the current block
+    size_t used = 0;                            // Bytes handed out from the current block
+    std::vector<std::unique_ptr<char[]>> retired;   // Full blocks of this frame (freed at reset)
+    size_t frame_bytes = 0;                     // Bytes used this frame, including retired blocks
+    size_t peak_bytes = 0;                      // Largest frame so far
+    size_t growth_count = 0;                    // Frames that needed an extra block
+
+    // Start a new block that can hold at least `size` bytes
+    void grow(size_t size);
+
+public:
+    // Create an arena with one block of `initial_capacity` bytes
+    explicit FrameArena(size_t initial_capacity = 16 * 1024);
+
+    // Release everything allocated since the last reset (call once per frame)
+    void reset();
+
+    // Get `size` bytes aligned to `alignment` (a power of two), valid until reset()
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // Format a string into the arena (printf syntax), valid until reset()
+    const char* format(const char* fmt, ...);
+
+    // Format a string into the arena from a va_list
+    const char* format_v(const char* fmt, va_list args);
+
+    // Bytes used this frame
+    size_t get_frame_bytes() const { return frame_bytes; }
+
+    // Largest number of bytes used by one frame
+    size_t get_peak_bytes() const { return peak_bytes; }
+
+    // Number of frames that outgrew the block
+    size_t get_growth_count() const { return growth_count; }
+};
+
+#endif
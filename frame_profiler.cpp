@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include "frame_profiler.h"
+
+// Allocate the history and event buffers up front
+FrameProfiler::FrameProfiler() : history(history_size) {
+    current_events.reserve(max_frame_events);
+    last_events.reserve(max_frame_events);
+}
+
+// Look up a zone by name or add it to the registry
+ProfileZoneId FrameProfiler::register_zone(const char* name) {
+    std::lock_guard<std::mutex> lock(zones_mutex);
+
+    size_t count = zone_count.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < count; i++) {
+        if (std::strcmp(zone_names[i], name) == 0) {
+            return static_cast<ProfileZoneId>(i);  // Same name used in several places
+        }
+    }
+
+    if (count == max_zones) {
+        std::cerr << "Warning: Profiler zone limit reached, zone \"" << name << "\" is not recorded" << std::endl;
+        return invalid_zone;
+    }
+
+    zone_names[count] = name;
+    zone_count.store(count + 1, std::memory_order_release);
+    return static_cast<ProfileZoneId>(count);
+}
+
+// Turn recording on or off
+void FrameProfiler::set_enabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+// Start a frame on the calling thread
+void FrameProfiler::begin_frame() {
+    in_frame = is_enabled();
+    tracing_frame = TraceRecorder::instance().is_capturing();
+    if (!in_frame && !tracing_frame) {
+        return;
+    }
+
+    if (in_frame) {
+        profiler_frame_thread = true;
+        depth = 0;
+        current = FrameSample();
+        current_events.clear();
+    }
+    frame_start = clock::now();
+}
+
+// Finish the frame and store it in the history
+void FrameProfiler::end_frame() {
+    if (!in_frame && !tracing_frame) {
+        return;
+    }
+
+    clock::time_point frame_end = clock::now();
+    if (tracing_frame) {
+        tracing_frame = false;
+        TraceRecorder::instance().record("Frame", frame_start, frame_end);
+    }
+    if (!in_frame) {
+        return;
+    }
+    in_frame = false;
+
+    current.frame_ms = std::chrono::duration<float, std::milli>(frame_end - frame_start).count();
+    history[history_next] = current;
+    history_next = (history_next + 1) % history_size;
+    history_count = std::min(history_count + 1, history_size);
+
+    last_events.swap(current_events);  // Both keep their capacity
+}
+
+// Enter a zone
+FrameProfiler::clock::time_point FrameProfiler::zone_begin(ProfileZoneId zone) {
+    zone_depths[zone] = depth;
+    depth++;
+    return clock::now();
+}
+
+// Leave a zone: add its time to the frame and keep the event for the flame view
+void FrameProfiler::zone_end(ProfileZoneId zone, clock::time_point start) {
+    clock::time_point end = clock::now();
+    if (depth > 0) {
+        depth--;
+    }
+
+    current.zone_ms[zone] += std::chrono::duration<float, std::milli>(end - start).count();
+    current.zone_calls[zone]++;
+
+    if (current_events.size() < max_frame_events) {
+        ZoneEvent event;
+        event.zone = zone;
+        event.depth = depth;
+        event.start_ms = std::chrono::duration<float, std::milli>(start - frame_start).count();
+        event.end_ms = std::chrono::duration<float, std::milli>(end - frame_start).count();
+        current_events.push_back(event);
+    }
+}
+
+// Drop all recorded frames
+void FrameProfiler::clear_history() {
+    history_next = 0;
+    history_count = 0;
+    last_events.clear();
+}
+
+// Frame from the history, 0 = oldest
+const FrameProfiler::FrameSample& FrameProfiler::get_frame(size_t index) const {
+    size_t oldest = (history_next + history_size - history_count) % history_size;
+    return history[(oldest + index) % history_size];
+}
@@ -0,0 +1,175 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include "trace_recorder.h"
+
+// Index of a registered timing zone
+using ProfileZoneId = uint16_t;
+
+// Set on the thread that calls begin_frame(); zones on other threads are not recorded
+inline thread_local bool profiler_frame_thread = false;
+
+// Per-frame CPU timing of named code zones
+//
+// Code is annotated with PROFILE_SCOPE("name"). While the profiler is
+// enabled, each zone entered on the frame thread between begin_frame() and
+// end_frame() adds its inclusive time to the current frame, and the last
+// history_size frames are kept in a ring buffer. Zones on any thread are
+// also recorded by TraceRecorder while a trace capture runs. When neither
+// is active, a zone costs two relaxed atomic loads.
+class FrameProfiler {
+public:
+    static constexpr size_t max_zones = 64;             // Distinct zone names
+    static constexpr size_t history_size = 300;         // Frames kept (5 s at 60 FPS)
+    static constexpr size_t max_frame_events = 1024;    // Zone events kept for the flame view
+    static constexpr ProfileZoneId invalid_zone = UINT16_MAX;
+
+    using clock = std::chrono::steady_clock;
+
+    // One zone execution in the last frame (times relative to the frame start)
+    struct ZoneEvent {
+        ProfileZoneId zone = 0;
+        uint16_t depth = 0;         // Nesting level (0 = outermost)
+        float start_ms = 0.0f;
+        float end_ms = 0.0f;
+    };
+
+    // Timings of one frame
+    struct FrameSample {
+        float frame_ms = 0.0f;                          // begin_frame() to end_frame()
+        std::array<float, max_zones> zone_ms{};         // Inclusive time per zone
+        std::array<uint16_t, max_zones> zone_calls{};   // Times each zone was entered
+    };
+
+private:
+    std::atomic<bool> enabled{false};
+
+    // Zone registry (registration is locked, lookups are not)
+    std::mutex zones_mutex;
+    std::array<const char*, max_zones> zone_names{};
+    std::array<uint16_t, max_zones> zone_depths{};      // Nesting level the zone was last seen at
+    std::atomic<size_t> zone_count{0};
+
+    // Frame thread state
+    bool in_frame = false;
+    bool tracing_frame = false;     // Frame is recorded by TraceRecorder
+    uint16_t depth = 0;
+    clock::time_point frame_start;
+    FrameSample current;
+    std::vector<ZoneEvent> current_events;
+    std::vector<ZoneEvent> last_events;     // Events of the last completed frame
+
+    // Ring buffer of completed frames
+    std::vector<FrameSample> history;
+    size_t history_next = 0;
+    size_t history_count = 0;
+
+    FrameProfiler();
+
+public:
+    // The process-wide profiler
+    static FrameProfiler& instance() {
+        static FrameProfiler profiler;
+        return profiler;
+    }
+
+    // Get the id of a zone, registering it on first use (`name` must outlive the profiler)
+    // Returns invalid_zone when max_zones names are already registered
+    ProfileZoneId register_zone(const char* name);
+
+    // Turn recording on or off (takes effect at the next begin_frame())
+    void set_enabled(bool value);
+
+    // Check if recording is turned on
+    bool is_enabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Check if a zone entered now on this thread would be recorded
+    bool is_recording() const {
+        return enabled.load(std::memory_order_relaxed) && profiler_frame_thread && in_frame;
+    }
+
+    // Start a frame on the calling thread
+    void begin_frame();
+
+    // Finish the frame and store it in the history
+    void end_frame();
+
+    // Enter a zone (only call when is_recording())
+    clock::time_point zone_begin(ProfileZoneId zone);
+
+    // Leave a zone entered at `start`
+    void zone_end(ProfileZoneId zone, clock::time_point start);
+
+    // Drop all recorded frames
+    void clear_history();
+
+    // Number of registered zones
+    size_t get_zone_count() const { return zone_count.load(std::memory_order_acquire); }
+
+    // Name of a registered zone
+    const char* get_zone_name(ProfileZoneId zone) const { return zone_names[zone]; }
+
+    // Nesting level a zone was last entered at
+    uint16_t get_zone_depth(ProfileZoneId zone) const { return zone_depths[zone]; }
+
+    // Number of frames in the history
+    size_t get_frame_count() const { return history_count; }
+
+    // Frame from the history, 0 = oldest
+    const FrameSample& get_frame(size_t index) const;
+
+    // Zone events of the last completed frame, in the order they ended
+    const std::vector<ZoneEvent>& get_last_frame_events() const { return last_events; }
+};
+
+// Times the enclosing scope as one zone
+class ProfileScope {
+private:
+    ProfileZoneId zone;
+    bool profiled;      // Recorded by FrameProfiler
+    bool traced;        // Recorded by TraceRecorder
+    FrameProfiler::clock::time_point start;
+
+public:
+    explicit ProfileScope(ProfileZoneId zone_id) : zone(zone_id) {
+        FrameProfiler& profiler = FrameProfiler::instance();
+        bool valid = zone != FrameProfiler::invalid_zone;
+        profiled = valid && profiler.is_recording();
+        traced = valid && TraceRecorder::instance().is_capturing();
+        if (profiled) {
+            start = profiler.zone_begin(zone);
+        } else if (traced) {
+            start = FrameProfiler::clock::now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (profiled) {
+            FrameProfiler::instance().zone_end(zone, start);
+        }
+        if (traced) {
+            TraceRecorder::instance().record(FrameProfiler::instance().get_zone_name(zone), start,
+                                             FrameProfiler::clock::now());
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// Time the rest of the enclosing scope as zone `name` (a string literal)
+#define PROFILE_SCOPE(name) \
+    static const ProfileZoneId PROFILE_CONCAT(profile_zone_, __LINE__) = FrameProfiler::instance().register_zone(name); \
+    ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(PROFILE_CONCAT(profile_zone_, __LINE__))
+
+#endif
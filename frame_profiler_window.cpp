@@ -0,0 +1,242 @@
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "imgui.h"
+#include "frame_profiler.h"
+#include "frame_profiler_window.h"
+#include "trace_recorder.h"
+
+// Percentile of the recorded frame times
+static float frame_time_percentile(const std::vector<float>& sorted, float q) {
+    if (sorted.empty()) {
+        return 0.0f;
+    }
+    size_t index = static_cast<size_t>(q * static_cast<float>(sorted.size() - 1) + 0.5f);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+// PlotLines callback: frame time of history entry `index`
+static float get_frame_ms(void* data, int index) {
+    const FrameProfiler* profiler = static_cast<const FrameProfiler*>(data);
+    return profiler->get_frame(static_cast<size_t>(index)).frame_ms;
+}
+
+// Draw a labelled horizontal line across the last item at value `ms`
+static void draw_percentile_line(const char* label, float ms, float scale_max, ImU32 color) {
+    ImVec2 min = ImGui::GetItemRectMin();
+    ImVec2 max = ImGui::GetItemRectMax();
+    ImVec2 padding = ImGui::GetStyle().FramePadding;
+    float inner_top = min.y + padding.y;
+    float inner_bottom = max.y - padding.y;
+
+    float y = inner_bottom - (std::min(ms, scale_max) / scale_max) * (inner_bottom - inner_top);
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    draw_list->AddLine(ImVec2(min.x, y), ImVec2(max.x, y), color);
+
+    char text[32];
+    std::snprintf(text, sizeof(text), "%s %.2f", label, ms);
+    draw_list->AddText(ImVec2(max.x - ImGui::CalcTextSize(text).x - padding.x, y - ImGui::GetTextLineHeight()),
+                       color, text);
+}
+
+// Frame-time graph of the whole history with p50/p90/p99 lines
+static void draw_frame_graph(const FrameProfiler& profiler, const std::vector<float>& sorted_ms) {
+    float p50 = frame_time_percentile(sorted_ms, 0.50f);
+    float p90 = frame_time_percentile(sorted_ms, 0.90f);
+    float p99 = frame_time_percentile(sorted_ms, 0.99f);
+    float scale_max = std::max(p99 * 1.5f, 1.0f);  // Spikes above 1.5x p99 are clipped
+
+    ImGui::Text("Frame time over %d frames: p50 %.2f ms, p90 %.2f ms, p99 %.2f ms, max %.2f ms",
+                static_cast<int>(sorted_ms.size()), p50, p90, p99, sorted_ms.empty() ? 0.0f : sorted_ms.back());
+    ImGui::PlotLines("##frame_times", get_frame_ms, const_cast<FrameProfiler*>(&profiler),
+                     static_cast<int>(profiler.get_frame_count()), 0, nullptr, 0.0f, scale_max,
+                     ImVec2(-1, 90));
+
+    draw_percentile_line("p50", p50, scale_max, IM_COL32(110, 220, 110, 255));
+    draw_percentile_line("p90", p90, scale_max, IM_COL32(230, 200, 80, 255));
+    draw_percentile_line("p99", p99, scale_max, IM_COL32(240, 90, 90, 255));
+}
+
+// Nested zones of the last frame laid out on a time axis
+static void draw_flame(const FrameProfiler& profiler) {
+    const std::vector<FrameProfiler::ZoneEvent>& events = profiler.get_last_frame_events();
+    if (events.empty() || profiler.get_frame_count() == 0) {
+        ImGui::TextDisabled("No zones recorded in the last frame");
+        return;
+    }
+
+    float frame_ms = profiler.get_frame(profiler.get_frame_count() - 1).frame_ms;
+    int max_depth = 0;
+    for (const FrameProfiler::ZoneEvent& event : events) {
+        max_depth = std::max(max_depth, static_cast<int>(event.depth));
+    }
+
+    float row_height = ImGui::GetTextLineHeight() + 4;
+    float width = ImGui::GetContentRegionAvail().x;
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImGui::InvisibleButton("##flame", ImVec2(width, row_height * (max_depth + 1)));
+    bool hovered = ImGui::IsItemHovered();
+    ImVec2 mouse = ImGui::GetIO().MousePos;
+
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    float scale = frame_ms > 0.0f ? width / frame_ms : 0.0f;
+    for (const FrameProfiler::ZoneEvent& event : events) {
+        ImVec2 min(origin.x + event.start_ms * scale, origin.y + event.depth * row_height);
+        ImVec2 max(std::max(origin.x + event.end_ms * scale, min.x + 1), min.y + row_height - 1);
+
+        // Stable color per zone
+        ImU32 color = ImColor::HSV(static_cast<float>(event.zone * 37 % 100) / 100.0f, 0.55f, 0.75f);
+        draw_list->AddRectFilled(min, max, color);
+
+        const char* name = profiler.get_zone_name(event.zone);
+        if (ImGui::CalcTextSize(name).x + 4 < max.x - min.x) {
+            draw_list->PushClipRect(min, max, true);
+            draw_list->AddText(ImVec2(min.x + 2, min.y + 2), IM_COL32(0, 0, 0, 255), name);
+            draw_list->PopClipRect();
+        }
+
+        if (hovered && mouse.x >= min.x && mouse.x < max.x && mouse.y >= min.y && mouse.y < max.y) {
+            ImGui::SetTooltip("%s\n%.3f ms (%.3f - %.3f)", name, event.end_ms - event.start_ms,
+                              event.start_ms, event.end_ms);
+        }
+    }
+}
+
+// Table of last/average/max time and share of the frame for every zone
+static void draw_zone_table(const FrameProfiler& profiler) {
+    size_t frames = profiler.get_frame_count();
+    size_t zone_count = profiler.get_zone_count();
+    if (frames == 0) {
+        return;
+    }
+
+    const FrameProfiler::FrameSample& last = profiler.get_frame(frames - 1);
+    double frame_total = 0.0;
+    for (size_t f = 0; f < frames; f++) {
+        frame_total += profiler.get_frame(f).frame_ms;
+    }
+    double frame_avg = frame_total / static_cast<double>(frames);
+
+    ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_SizingStretchProp;
+    if (!ImGui::BeginTable("##zones", 6, flags)) {
+        return;
+    }
+    ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_WidthStretch, 3.0f);
+    ImGui::TableSetupColumn("Last ms");
+    ImGui::TableSetupColumn("Avg ms");
+    ImGui::TableSetupColumn("Max ms");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableSetupColumn("Share of frame", ImGuiTableColumnFlags_WidthStretch, 2.0f);
+    ImGui::TableHeadersRow();
+
+    for (size_t z = 0; z < zone_count; z++) {
+        double total = 0.0;
+        float max_ms = 0.0f;
+        for (size_t f = 0; f < frames; f++) {
+            float ms = profiler.get_frame(f).zone_ms[z];
+            total += ms;
+            max_ms = std::max(max_ms, ms);
+        }
+        if (max_ms == 0.0f) {
+            continue;  // Zone not entered during the recorded frames
+        }
+        double avg = total / static_cast<double>(frames);
+        ProfileZoneId zone = static_cast<ProfileZoneId>(z);
+
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::Indent(profiler.get_zone_depth(zone) * 12.0f + 1.0f);
+        ImGui::TextUnformatted(profiler.get_zone_name(zone));
+        ImGui::Unindent(profiler.get_zone_depth(zone) * 12.0f + 1.0f);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", last.zone_ms[z]);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", avg);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f", max_ms);
+        ImGui::TableNextColumn();
+        ImGui::Text("%d", static_cast<int>(last.zone_calls[z]));
+        ImGui::TableNextColumn();
+        float share = frame_avg > 0.0 ? static_cast<float>(avg / frame_avg) : 0.0f;
+        char overlay[16];
+        std::snprintf(overlay, sizeof(overlay), "%.1f%%", share * 100.0f);
+        ImGui::ProgressBar(share, ImVec2(-1, 0), overlay);
+    }
+    ImGui::EndTable();
+}
+
+// Start/stop a Chrome trace capture of all threads and save it
+static void draw_trace_controls(FrameProfilerWindowState& state) {
+    TraceRecorder& recorder = TraceRecorder::instance();
+
+    if (recorder.is_capturing()) {
+        ImGui::Text("Recording: %d events, %d dropped", static_cast<int>(recorder.get_event_count()),
+                    static_cast<int>(recorder.get_dropped_count()));
+        ImGui::SameLine();
+        if (ImGui::Button("Stop and save")) {
+            recorder.stop_capture();
+            if (recorder.write_chrome_trace(state.trace_path)) {
+                state.trace_status = "Saved " + std::to_string(recorder.get_event_count()) + " events to " +
+                                     state.trace_path + " (open in ui.perfetto.dev or chrome://tracing)";
+            } else {
+                state.trace_status = std::string("Error: Cannot write ") + state.trace_path;
+            }
+        }
+    } else {
+        ImGui::SetNextItemWidth(240);
+        ImGui::InputText("##trace_path", state.trace_path, IM_ARRAYSIZE(state.trace_path));
+        ImGui::SameLine();
+        if (ImGui::Button("Start trace capture")) {
+            recorder.start_capture();
+            state.trace_status.clear();
+        }
+    }
+
+    if (!state.trace_status.empty()) {
+        ImGui::TextWrapped("%s", state.trace_status.c_str());
+    }
+}
+
+// Draw the frame profiler window
+void DrawFrameProfilerWindow(FrameProfilerWindowState& state) {
+    FrameProfiler& profiler = FrameProfiler::instance();
+    profiler.set_enabled(state.open && !state.paused);
+    if (!state.open) {
+        return;
+    }
+
+    ImGui::SetNextWindowSize(ImVec2(640, 520), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Frame Profiler (F3)", &state.open)) {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::Checkbox("Pause", &state.paused);
+    ImGui::SameLine();
+    if (ImGui::Button("Clear")) {
+        profiler.clear_history();
+    }
+
+    // Sorted copy of the frame times for the percentiles
+    std::vector<float>& sorted_ms = state.sorted_ms;
+    sorted_ms.reserve(FrameProfiler::history_size);  // Allocates once, not while the history fills
+    sorted_ms.resize(profiler.get_frame_count());
+    for (size_t i = 0; i < sorted_ms.size(); i++) {
+        sorted_ms[i] = profiler.get_frame(i).frame_ms;
+    }
+    std::sort(sorted_ms.begin(), sorted_ms.end());
+
+    draw_frame_graph(profiler, sorted_ms);
+
+    ImGui::SeparatorText("Last frame");
+    draw_flame(profiler);
+
+    ImGui::SeparatorText("Zones");
+    draw_zone_table(profiler);
+
+    ImGui::SeparatorText("Trace capture (all threads)");
+    draw_trace_controls(state);
+
+    ImGui::End();
+}
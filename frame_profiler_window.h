@@ -0,0 +1,23 @@
+#ifndef FRAME_PROFILER_WINDOW_H
+#define FRAME_PROFILER_WINDOW_H
+
+#include <string>
+#include <vector>
+
+// UI state of the profiler window
+struct FrameProfilerWindowState {
+    bool open = false;      // Window shown (the profiler records only while it is)
+    bool paused = false;    // Keep the current history on screen
+
+    std::vector<float> sorted_ms;   // Scratch buffer for the frame-time percentiles
+
+    char trace_path[256] = "trace.json";    // Output file of trace captures
+    std::string trace_status;               // Result of the last trace export
+};
+
+// Draw the frame profiler window: frame-time graph with percentile lines,
+// flame view of the last frame, per-zone breakdown and trace capture controls
+// Also turns recording on or off to match the window state.
+void DrawFrameProfilerWindow(FrameProfilerWindowState& state);
+
+#endif
@@ -4,166 +4,9 @@
 #include "backends/imgui_impl_glfw.h"
 #include "backends/imgui_impl_opengl3.h"
 #include "task_manager.h"
-#include "task.h"
-
-// Application state structure to manage UI modal states and input buffers
-struct AppState {
-    bool show_add_task_modal = false;           // Flag to show/hide add task modal
-    bool show_mark_task_modal = false;          // Flag to show/hide mark task modal
-    bool show_mark_delete_task_modal = false;   // Flag to show/hide delete task modal
-    
-    char task_input_buffer[256] = "";           // Buffer for storing new task input
-    bool task_input_focused = false;            // Flag to focus on task input field
-};
-
-// Function to draw a modal for task selection (marking or deletion)
-// Returns true if user confirms the action, false otherwise
-bool DrawTaskSelectionModal(
-    const char* title,              // Modal title
-    const char* confirm_button_text,// Text for confirm button
-    TaskManager& task_manager,      // Reference to task manager
-    bool& show_modal_flag)          // Flag to control modal visibility
-{
-    bool result = false;            // Return value indicating user action
-    
-    // Open modal when flag is set
-    if (show_modal_flag) {
-        ImGui::OpenPopup(title);
-        task_manager.init_selection_states();  // Initialize selection states
-        show_modal_flag = false;               // Reset flag after opening
-    }
-
-    // Set modal position and size
-    ImGui::SetNextWindowPos(ImGui::GetMainViewport()->GetCenter(), ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
-    ImGui::SetNextWindowSize(ImVec2(750, 600), ImGuiCond_FirstUseEver);
-
-    // Begin modal popup
-    if (ImGui::BeginPopupModal(title, NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoScrollbar)) {
-        // Close modal on Escape key press
-        if (ImGui::IsKeyPressed(ImGuiKey_Escape)) {
-            task_manager.clear_selection();  // Clear any selections
-            ImGui::CloseCurrentPopup();      // Close modal
-        }
-
-        // Center the title text
-        ImGui::SetCursorPosX((ImGui::GetWindowWidth() - ImGui::CalcTextSize(title).x) * 0.5f);
-        ImGui::Text("%s", title);
-        ImGui::Separator();
-        
-        // Calculate content area height (remaining space minus button area)
-        float content_height = ImGui::GetContentRegionAvail().y - 50;
-        ImGui::BeginChild("ContentArea", ImVec2(0, content_height), false, ImGuiWindowFlags_NoScrollbar);
-        
-        // Create two columns for uncompleted and completed tasks
-        ImGui::Columns(2, "task_columns", true);
-        float column_width = (ImGui::GetWindowWidth() - ImGui::GetStyle().ItemSpacing.x) * 0.5f;
-        ImGui::SetColumnWidth(0, column_width);  // Set left column width
-        ImGui::SetColumnWidth(1, column_width);  // Set right column width
-
-        // Left column: Uncompleted tasks
-        ImGui::BeginChild("LeftColumn", ImVec2(0, 0), false);
-        ImGui::TextColored(ImVec4(1, 0.5f, 0.5f, 1), "To Complete");
-        ImGui::Separator();
-        
-        // Scrollable area for uncompleted tasks
-        ImGui::BeginChild("LeftScroll", ImVec2(0, -1), true, ImGuiWindowFlags_AlwaysVerticalScrollbar);
-        std::vector<Task> uncompleted_tasks = task_manager.get_uncompleted_tasks();
-
-        // Display each uncompleted task with checkbox
-        int display_index = 1;
-        for (const Task& task : uncompleted_tasks) {
-            std::string task_label = std::to_string(display_index) + ". " + task.title;
-            
-            // Checkbox for task selection
-            bool current_selection = task_manager.is_task_selected(task.id);
-            if (ImGui::Checkbox(("##task_" + task.id).c_str(), &current_selection)) {
-                task_manager.toggle_task_selection(task.id);  // Toggle selection state
-            }
-            
-            ImGui::SameLine();
-            ImGui::TextWrapped("%s", task_label.c_str());  // Display task text
-            display_index++;
-        }
-        ImGui::EndChild();  // End LeftScroll
-        ImGui::EndChild();  // End LeftColumn
-
-        // Right column: Completed tasks
-        ImGui::NextColumn();
-        ImGui::BeginChild("RightColumn", ImVec2(0, 0), false);
-        ImGui::TextColored(ImVec4(0.5f, 1, 0.5f, 1), "Completed");
-        ImGui::Separator();
-        
-        // Scrollable area for completed tasks
-        ImGui::BeginChild("RightScroll", ImVec2(0, -1), true, ImGuiWindowFlags_AlwaysVerticalScrollbar);
-        std::vector<Task> completed_tasks = task_manager.get_completed_tasks();
-
-        // Display each completed task with checkbox
-        display_index = 1;
-        for (const Task& task : completed_tasks) {
-            std::string task_label = std::to_string(display_index) + ". " + task.title;
-            
-            // Checkbox for task selection
-            bool current_selection = task_manager.is_task_selected(task.id);
-            if (ImGui::Checkbox(("##task_" + task.id).c_str(), &current_selection)) {
-                task_manager.toggle_task_selection(task.id);  // Toggle selection state
-            }
-            
-            ImGui::SameLine();
-            ImGui::TextWrapped("%s", task_label.c_str());  // Display task text
-            display_index++;
-        }
-        ImGui::EndChild();  // End RightScroll
-        ImGui::EndChild();  // End RightColumn
-
-        ImGui::Columns(1);  // Reset to single column
-        ImGui::EndChild();  // End ContentArea
-        ImGui::Separator();
-        
-        // Button area at the bottom of the modal
-        ImGui::BeginChild("ButtonArea", ImVec2(0, 0), false);
-        
-        // Check if any tasks are selected
-        bool has_selection = task_manager.has_selection();
-
-        // Calculate button positioning
-        float button_width = 100;
-        float spacing = ImGui::GetStyle().ItemSpacing.x;
-        float total_width = button_width * 2 + spacing;
-        float start_x = (ImGui::GetWindowWidth() - total_width) * 0.5f;
-        
-        ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 5);  // Add vertical spacing
-        
-        // Disable confirm button if no tasks are selected
-        if (!has_selection) {
-            ImGui::BeginDisabled();
-        }
-        
-        ImGui::SetCursorPosX(start_x);
-        
-        // Confirm button - performs the action (mark/delete)
-        if (ImGui::Button(confirm_button_text, ImVec2(button_width, 30))) {
-            result = true;  // User confirmed the action
-            ImGui::CloseCurrentPopup();  // Close modal
-        }  
-        
-        if (!has_selection) {
-            ImGui::EndDisabled();
-        }
-        
-        ImGui::SameLine();
-        
-        // Cancel button - closes modal without action
-        if (ImGui::Button("Cancel", ImVec2(button_width, 30))) {
-            task_manager.clear_selection();  // Clear selections
-            ImGui::CloseCurrentPopup();      // Close modal
-        }
-        
-        ImGui::EndChild();  // End ButtonArea
-        ImGui::EndPopup();  // End modal
-    }
-    
-    return result;  // Return whether user confirmed the action
-}
+#include "task_ui.h"
+#include "frame_profiler.h"
+#include "render_scheduler.h"
 
 // GLFW error callback function
 static void glfw_error_callback(int error, const char* description)
@@ -189,6 +32,25 @@ void check_gl_errors(const char* context) {
     }
 }
 
+// Schedule frames for the window's render scheduler (any input or window event)
+static void schedule_redraw(GLFWwindow* window) {
+    static_cast<RenderScheduler*>(glfwGetWindowUserPointer(window))->on_input();
+}
+
+// GLFW input callbacks (installed before the ImGui backend, which chains to them)
+static void cursor_pos_callback(GLFWwindow* window, double, double) { schedule_redraw(window); }
+static void cursor_enter_callback(GLFWwindow* window, int) { schedule_redraw(window); }
+static void mouse_button_callback(GLFWwindow* window, int, int, int) { schedule_redraw(window); }
+static void scroll_callback(GLFWwindow* window, double, double) { schedule_redraw(window); }
+static void key_callback(GLFWwindow* window, int, int, int, int) { schedule_redraw(window); }
+static void char_callback(GLFWwindow* window, unsigned int) { schedule_redraw(window); }
+static void window_focus_callback(GLFWwindow* window, int) { schedule_redraw(window); }
+
+// GLFW window callbacks (resize, expose, restore)
+static void window_size_callback(GLFWwindow* window, int, int) { schedule_redraw(window); }
+static void window_refresh_callback(GLFWwindow* window) { schedule_redraw(window); }
+static void window_iconify_callback(GLFWwindow* window, int) { schedule_redraw(window); }
+
 // Main application entry point
 int main() {
     // Set GLFW error callback
@@ -210,6 +72,20 @@ int main() {
     glfwMakeContextCurrent(window);  // Make the window's context current
     glfwSwapInterval(1);  // Enable vsync
 
+    // Render on demand: events wake the loop and schedule frames
+    RenderScheduler scheduler;
+    glfwSetWindowUserPointer(window, &scheduler);
+    glfwSetCursorPosCallback(window, cursor_pos_callback);
+    glfwSetCursorEnterCallback(window, cursor_enter_callback);
+    glfwSetMouseButtonCallback(window, mouse_button_callback);
+    glfwSetScrollCallback(window, scroll_callback);
+    glfwSetKeyCallback(window, key_callback);
+    glfwSetCharCallback(window, char_callback);
+    glfwSetWindowFocusCallback(window, window_focus_callback);
+    glfwSetWindowSizeCallback(window, window_size_callback);
+    glfwSetWindowRefreshCallback(window, window_refresh_callback);
+    glfwSetWindowIconifyCallback(window, window_iconify_callback);
+
     // Check for OpenGL errors after initialization
     check_gl_errors("Initialization");
 
@@ -228,226 +104,72 @@ int main() {
 
     // Initialize application state and task manager
     TaskManager task_manager;
+    TaskViewModel view_model;  // Cached task lists, rebuilt only when tasks change
     AppState state;
 
     // Main application loop
+    FrameProfiler& profiler = FrameProfiler::instance();  // Records only while its window is open (F3)
+    TraceRecorder::instance().set_thread_name("UI");
     while (!glfwWindowShouldClose(window)) {
-        glfwPollEvents();  // Process events
-
-        // Start new ImGui frame
-        ImGui_ImplOpenGL3_NewFrame();
-        ImGui_ImplGlfw_NewFrame();
-        ImGui::NewFrame();
-
-        // Get current window size
-        int window_width, window_height;
-        glfwGetWindowSize(window, &window_width, &window_height);
-
-        // Create main application window (fullscreen)
-        ImGui::SetNextWindowPos(ImVec2(0, 0));
-        ImGui::SetNextWindowSize(ImVec2((float)window_width, (float)window_height));
-        ImGui::Begin("MainWindow", nullptr, 
-            ImGuiWindowFlags_NoTitleBar | 
-            ImGuiWindowFlags_NoResize | 
-            ImGuiWindowFlags_NoMove);
-
-        // Calculate panel widths with margins
-        float margin = 20.0f;
-        float panel_width = (window_width - 3 * margin) / 3;
-        
-        // Left panel: Control buttons
-        ImGui::BeginChild("LeftPanel", ImVec2(panel_width, -1), true);
-        
-        ImGui::Text("Control Panel");
-        ImGui::Separator();
-        ImGui::Dummy(ImVec2(0, 10));  // Add spacing
-        
-        // Button to mark tasks as complete/incomplete
-        if (ImGui::Button("Mark Task", ImVec2(-1, 0))) {
-            state.show_mark_task_modal = true;  // Show mark task modal
-        }
-        ImGui::Dummy(ImVec2(0, 10));
-        
-        // Button to add new task
-        if (ImGui::Button("Add New Task", ImVec2(-1, 0))) {
-            state.show_add_task_modal = true;  // Show add task modal
-            state.task_input_buffer[0] = '\0'; // Clear input buffer
-            state.task_input_focused = true;   // Set focus flag
-        }
-        ImGui::Dummy(ImVec2(0, 10));
-        
-        // Button to delete tasks
-        if (ImGui::Button("Delete Task", ImVec2(-1, 0))) {
-            state.show_mark_delete_task_modal = true;  // Show delete task modal
-        }
-        ImGui::Dummy(ImVec2(0, 10));
-        
-        // Exit button
-        if (ImGui::Button("Exit", ImVec2(-1, 0))) {
-            glfwSetWindowShouldClose(window, true);  // Close application
+        // Draw nothing while minimized; block until the window is restored or closed
+        if (glfwGetWindowAttrib(window, GLFW_ICONIFIED)) {
+            glfwWaitEvents();
+            continue;
         }
-        
-        ImGui::EndChild();  // End LeftPanel
-
-        ImGui::SameLine(0, margin);  // Move to next panel with margin
-
-        // Center panel: Uncompleted tasks list
-        ImGui::BeginChild("CenterPanel", ImVec2(panel_width, -1), true, ImGuiWindowFlags_AlwaysVerticalScrollbar);
-
-        ImGui::TextColored(ImVec4(1, 0.5f, 0.5f, 1), "Uncompleted Tasks");
-        ImGui::Separator();
-        ImGui::Dummy(ImVec2(0, 10));
 
-        // Get and display uncompleted tasks
-        std::vector<Task> uncompleted_tasks = task_manager.get_uncompleted_tasks();
-
-        if (uncompleted_tasks.empty()) {
-            ImGui::Text("No uncompleted tasks information");
+        // Poll when a frame is due, otherwise sleep until an event or the idle timeout
+        if (scheduler.should_render()) {
+            glfwPollEvents();
         } else {
-            int task_index = 1;
-            for (const Task& task : uncompleted_tasks) {
-                std::string task_label = std::to_string(task_index) + ". " + task.title;
-                ImGui::TextWrapped("%s", task_label.c_str());  // Display task with wrapping
-                task_index++;
-                ImGui::Dummy(ImVec2(0, 10));  // Add spacing between tasks
-            }
+            glfwWaitEventsTimeout(scheduler.get_wait_timeout());
         }
+        scheduler.check_generation(task_manager.get_generation());  // Redraw after data changes
 
-        ImGui::EndChild();  // End CenterPanel
-
-        ImGui::SameLine(0, margin);  // Move to next panel with margin
-
-        // Right panel: Completed tasks list
-        ImGui::BeginChild("RightPanel", ImVec2(panel_width, -1), true, ImGuiWindowFlags_AlwaysVerticalScrollbar);
-
-        ImGui::TextColored(ImVec4(0.5f, 1, 0.5f, 1), "Completed Tasks");
-        ImGui::Separator();
-        ImGui::Dummy(ImVec2(0, 10));
-
-        // Get and display completed tasks
-        std::vector<Task> completed_tasks = task_manager.get_completed_tasks();
-
-        if (completed_tasks.empty()) {
-            ImGui::Text("No completed tasks");
-        } else {
-            int task_index = 1;
-            for (const Task& task : completed_tasks) {
-                std::string task_label = std::to_string(task_index) + ". " + task.title;
-                ImGui::TextWrapped("%s", task_label.c_str());  // Display task with wrapping
-                task_index++;
-                ImGui::Dummy(ImVec2(0, 10));  // Add spacing between tasks
-            }
+        if (!scheduler.should_render()) {
+            scheduler.on_idle_wakeup();
+            continue;
         }
 
-        ImGui::EndChild();  // End RightPanel
+        profiler.begin_frame();
 
-        // Handle mark task modal
-        if (state.show_mark_task_modal) {
-            ImGui::OpenPopup("Mark Tasks");
-            state.show_mark_task_modal = false;
+        // Start new ImGui frame
+        {
+            PROFILE_SCOPE("NewFrame");
+            ImGui_ImplOpenGL3_NewFrame();
+            ImGui_ImplGlfw_NewFrame();
+            ImGui::NewFrame();
         }
 
-        // If user confirms marking tasks, toggle their status
-        if (DrawTaskSelectionModal("Mark Tasks", "Confirm", task_manager, state.show_mark_task_modal)) {
-            auto selected_ids = task_manager.get_selected_task_ids();
-            for (const std::string& task_id : selected_ids) {
-                task_manager.toggle_task_status(task_id);  // Toggle completion status
-            }
-            task_manager.clear_selection();  // Clear selection after operation
-        }
+        // Get current window size
+        int window_width, window_height;
+        glfwGetWindowSize(window, &window_width, &window_height);
 
-        // Handle delete task modal
-        if (state.show_mark_delete_task_modal) {
-            ImGui::OpenPopup("Delete Tasks");
-            state.show_mark_delete_task_modal = false;
+        // Build the UI for this frame
+        DrawMainWindow(task_manager, view_model, state, ImVec2((float)window_width, (float)window_height));
+        if (state.exit_requested) {
+            glfwSetWindowShouldClose(window, true);  // Close application
         }
 
-        // If user confirms deletion, delete selected tasks
-        if (DrawTaskSelectionModal("Delete Tasks", "Confirm", task_manager, state.show_mark_delete_task_modal)) {
-            auto selected_ids = task_manager.get_selected_task_ids();
-            for (const std::string& task_id : selected_ids) {
-                task_manager.delete_task(task_id);  // Delete task
-            }
-            task_manager.clear_selection();  // Clear selection after operation
+        // Render ImGui and swap buffers
+        {
+            PROFILE_SCOPE("ImGui::Render");
+            ImGui::Render();
         }
-
-        // Handle add task modal
-        if (state.show_add_task_modal) {
-            ImGui::OpenPopup("Add New Task");
-            state.show_add_task_modal = false;
+        {
+            PROFILE_SCOPE("RenderDrawData");
+            glClearColor(0.15f, 0.15f, 0.2f, 1.0f);  // Set clear color
+            glClear(GL_COLOR_BUFFER_BIT);             // Clear screen
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());  // Render ImGui
         }
-
-        // Position add task modal in center of screen
-        ImVec2 center = ImGui::GetMainViewport()->GetCenter();
-        ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
-
-        // Add new task modal
-        if (ImGui::BeginPopupModal("Add New Task", NULL, ImGuiWindowFlags_AlwaysAutoResize)) {
-            // Close modal on Escape key
-            if (ImGui::IsKeyPressed(ImGuiKey_Escape)) {
-                ImGui::CloseCurrentPopup();
-                state.task_input_buffer[0] = '\0';  // Clear input buffer
-            }
-
-            ImGui::Text("Enter task name:");
-            
-            // Set keyboard focus to input field if requested
-            if (state.task_input_focused) {
-                ImGui::SetKeyboardFocusHere();
-                state.task_input_focused = false;
-            }
-            
-            // Input text field for new task name
-            if (ImGui::InputText("##task_input", state.task_input_buffer, IM_ARRAYSIZE(state.task_input_buffer), 
-                                ImGuiInputTextFlags_EnterReturnsTrue)) {
-                // Add task when Enter is pressed and input is not empty
-                if (strlen(state.task_input_buffer) > 0) {
-                    std::string task_string = state.task_input_buffer;
-                    task_manager.add_task(task_string);  // Add new task
-                    ImGui::CloseCurrentPopup();          // Close modal
-                }
-            }
-            
-            ImGui::Separator();
-            
-            // Center the buttons
-            float width = ImGui::GetContentRegionAvail().x;
-            ImGui::SetCursorPosX((width - 200) * 0.5f);
-            
-            // Disable confirm button if input is empty
-            if (strlen(state.task_input_buffer) == 0) {
-                ImGui::BeginDisabled();
-            }
-            
-            // Confirm button to add task
-            if (ImGui::Button("Confirm", ImVec2(80, 0))) {
-                std::string task_string = state.task_input_buffer;
-                task_manager.add_task(task_string);  // Add new task
-                ImGui::CloseCurrentPopup();          // Close modal
-            }
-            
-            if (strlen(state.task_input_buffer) == 0) {
-                ImGui::EndDisabled();
-            }
-            
-            ImGui::SameLine();
-            
-            // Cancel button to close modal without adding task
-            if (ImGui::Button("Cancel", ImVec2(80, 0))) {
-                ImGui::CloseCurrentPopup();
-            }
-            
-            ImGui::EndPopup();  // End add task modal
+        {
+            PROFILE_SCOPE("glfwSwapBuffers");
+            glfwSwapBuffers(window);                  // Swap front and back buffers (waits for vsync)
         }
 
-        ImGui::End();  // End MainWindow
+        profiler.end_frame();
 
-        // Render ImGui and swap buffers
-        ImGui::Render();
-        glClearColor(0.15f, 0.15f, 0.2f, 1.0f);  // Set clear color
-        glClear(GL_COLOR_BUFFER_BIT);             // Clear screen
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());  // Render ImGui
-        glfwSwapBuffers(window);                  // Swap front and back buffers
+        scheduler.on_frame_rendered();
+        scheduler.set_continuous(NeedsContinuousRendering(state));  // Held buttons, text caret, live graphs
     }
 
     // Cleanup
@@ -0,0 +1,135 @@
+#include "mapped_file.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+// Destructor: Releases the mapping
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+// Map a file using CreateFileMapping/MapViewOfFile
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+        CloseHandle(file);  // Empty files cannot be mapped
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping == NULL) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (view == NULL) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    file_handle = file;
+    mapping_handle = mapping;
+    mapped_data = static_cast<const char*>(view);
+    mapped_size = static_cast<size_t>(file_size.QuadPart);
+    return true;
+}
+
+// Unmap the view and close both handles
+void MappedFile::close() {
+    if (mapped_data) {
+        UnmapViewOfFile(mapped_data);
+    }
+    if (mapping_handle) {
+        CloseHandle(static_cast<HANDLE>(mapping_handle));
+    }
+    if (file_handle) {
+        CloseHandle(static_cast<HANDLE>(file_handle));
+    }
+
+    mapped_data = nullptr;
+    mapped_size = 0;
+    mapping_handle = nullptr;
+    file_handle = nullptr;
+}
+
+#else
+
+// Map a file using mmap
+bool MappedFile::open(const std::string& path) {
+    close();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+        ::close(fd);  // Empty files cannot be mapped
+        return false;
+    }
+
+    size_t length = static_cast<size_t>(file_stat.st_size);
+    void* view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) {
+        ::close(fd);
+        return false;
+    }
+
+    madvise(view, length, MADV_SEQUENTIAL);  // Records are read front to back
+
+    file_descriptor = fd;
+    mapped_data = static_cast<const char*>(view);
+    mapped_size = length;
+    return true;
+}
+
+// Unmap the file and close the descriptor
+void MappedFile::close() {
+    if (mapped_data) {
+        munmap(const_cast<char*>(mapped_data), mapped_size);
+    }
+    if (file_descriptor >= 0) {
+        ::close(file_descriptor);
+    }
+
+    mapped_data = nullptr;
+    mapped_size = 0;
+    file_descriptor = -1;
+}
+
+#endif
+
+// Get pointer to mapped bytes
+const char* MappedFile::data() const {
+    return mapped_data;
+}
+
+// Get mapped size
+size_t MappedFile::size() const {
+    return mapped_size;
+}
+
+// Check if a file is mapped
+bool MappedFile::is_open() const {
+    return mapped_data != nullptr;
+}
@@ -0,0 +1,49 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+#include <cstddef>
+
+// Read-only memory mapping of a whole file
+// Pages are loaded by the OS on first access, so only the parts that are
+// actually read get touched.
+class MappedFile {
+private:
+    const char* mapped_data = nullptr;   // Start of the mapped view
+    size_t mapped_size = 0;              // Size of the mapping in bytes
+
+#ifdef _WIN32
+    void* file_handle = nullptr;         // HANDLE of the opened file
+    void* mapping_handle = nullptr;      // HANDLE of the file mapping object
+#else
+    int file_descriptor = -1;            // Descriptor of the opened file
+#endif
+
+    // Release the mapping and close handles
+    void close();
+
+public:
+    // Constructor: Creates an empty (unmapped) file view
+    MappedFile() = default;
+
+    // Destructor: Unmaps the file
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map the file at the given path read-only
+    // Returns false if the file cannot be opened or is empty
+    bool open(const std::string& path);
+
+    // Pointer to the first byte of the mapping (nullptr when not mapped)
+    const char* data() const;
+
+    // Size of the mapping in bytes
+    size_t size() const;
+
+    // Check if a file is currently mapped
+    bool is_open() const;
+};
+
+#endif
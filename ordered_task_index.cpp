@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "ordered_task_index.h"
+#include "frame_profiler.h"
+
+// Append a slot, keeping the sorted prefix when the id is the largest so far
+void OrderedTaskIndex::insert(uint32_t slot, const TaskId& id) {
+    if (slot >= positions.size()) {
+        positions.resize(static_cast<size_t>(slot) + 1);
+    }
+
+    bool in_order = sorted_count == entries.size() && (keys.empty() || keys.back() < id);
+
+    positions[slot] = static_cast<uint32_t>(entries.size());
+    entries.push_back(slot);
+    keys.push_back(id);
+    live++;
+
+    if (in_order) {
+        sorted_count = entries.size();
+    }
+}
+
+// Replace a slot's entry with a tombstone
+void OrderedTaskIndex::remove(uint32_t slot) {
+    entries[positions[slot]] = tombstone;  // Key stays, so the prefix remains sorted
+    live--;
+}
+
+// Remove all entries
+void OrderedTaskIndex::clear() {
+    entries.clear();
+    keys.clear();
+    sorted_count = 0;
+    live = 0;
+}
+
+// Rebuild the entries in id order without tombstones
+void OrderedTaskIndex::normalize() {
+    if (is_normalized()) {
+        return;
+    }
+    PROFILE_SCOPE("OrderedTaskIndex::normalize");
+
+    // Sort the live part of the unsorted tail on its own (usually small)
+    std::vector<std::pair<TaskId, uint32_t>> tail;
+    for (size_t i = sorted_count; i < entries.size(); i++) {
+        if (entries[i] != tombstone) {
+            tail.emplace_back(keys[i], entries[i]);
+        }
+    }
+    std::sort(tail.begin(), tail.end(),
+              [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    // Compact the sorted prefix in place
+    size_t write = 0;
+    for (size_t i = 0; i < sorted_count; i++) {
+        if (entries[i] == tombstone) {
+            continue;
+        }
+        if (write != i) {
+            entries[write] = entries[i];
+            keys[write] = keys[i];
+            positions[entries[write]] = static_cast<uint32_t>(write);
+        }
+        write++;
+    }
+
+    // Merge the tail in from the back, so only entries after its smallest id move
+    entries.resize(write + tail.size());
+    keys.resize(write + tail.size());
+    size_t target = entries.size();
+    size_t i = write;
+    size_t t = tail.size();
+    while (t > 0) {
+        target--;
+        if (i > 0 && tail[t - 1].first < keys[i - 1]) {
+            i--;
+            entries[target] = entries[i];
+            keys[target] = keys[i];
+        } else {
+            t--;
+            entries[target] = tail[t].second;
+            keys[target] = tail[t].first;
+        }
+        positions[entries[target]] = static_cast<uint32_t>(target);
+    }
+
+    sorted_count = entries.size();
+}
+
+// Binary search over the sorted keys
+size_t OrderedTaskIndex::lower_bound(const TaskId& id) const {
+    return static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), id) - keys.begin());
+}
@@ -0,0 +1,53 @@
+#ifndef ORDERED_TASK_INDEX_H
+#define ORDERED_TASK_INDEX_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "task_id.h"
+
+// Task slots kept in TaskId order
+//
+// Inserting an id larger than every id seen so far (the normal case for
+// time-ordered ids) appends in O(1); any other insert goes to an unsorted
+// tail. Removal leaves a tombstone in O(1). normalize() drops tombstones
+// and merges the tail back in O(n + k log k), and must be called before
+// slots() or the range lookups are used.
+class OrderedTaskIndex {
+private:
+    static constexpr uint32_t tombstone = UINT32_MAX;
+
+    std::vector<uint32_t> entries;      // Slot indices (or tombstones)
+    std::vector<TaskId> keys;           // Id of each entry, parallel to entries
+    std::vector<uint32_t> positions;    // Position of each slot in entries, indexed by slot
+
+    size_t sorted_count = 0;            // entries[0, sorted_count) are in id order
+    size_t live = 0;                    // Entries that are not tombstones
+
+public:
+    // Add a slot with its id
+    void insert(uint32_t slot, const TaskId& id);
+
+    // Remove a slot (must have been inserted)
+    void remove(uint32_t slot);
+
+    // Remove everything
+    void clear();
+
+    // Number of slots in the index
+    size_t size() const { return live; }
+
+    // Check if slots() is usable without normalize()
+    bool is_normalized() const { return sorted_count == entries.size() && live == entries.size(); }
+
+    // Drop tombstones and merge out-of-order inserts (no-op if already normalized)
+    void normalize();
+
+    // Slots in id order (only valid when normalized)
+    const std::vector<uint32_t>& slots() const { return entries; }
+
+    // Position of the first slot whose id is not less than `id` (only valid when normalized)
+    size_t lower_bound(const TaskId& id) const;
+};
+
+#endif
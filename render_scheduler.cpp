@@ -0,0 +1,68 @@
+#include <algorithm>
+#include "render_scheduler.h"
+
+// Set the number of frames rendered after each input or data change
+void RenderScheduler::set_frames_after_input(int frames) {
+    frames_after_input = std::max(frames, 1);
+}
+
+// Set the longest time to block without events
+void RenderScheduler::set_idle_timeout(double seconds) {
+    idle_timeout = std::max(seconds, 0.0);
+}
+
+// Input arrived: render it and let ImGui settle
+void RenderScheduler::on_input() {
+    pending_frames = std::max(pending_frames, frames_after_input);
+}
+
+// Request a single frame
+void RenderScheduler::request_frame() {
+    pending_frames = std::max(pending_frames, 1);
+}
+
+// Schedule frames when the task data changed
+void RenderScheduler::check_generation(uint64_t generation) {
+    if (generation != last_generation) {
+        last_generation = generation;
+        pending_frames = std::max(pending_frames, frames_after_input);
+    }
+}
+
+// Render every frame while `value` is true
+void RenderScheduler::set_continuous(bool value) {
+    continuous = value;
+}
+
+// Check if a frame should be drawn now
+bool RenderScheduler::should_render() const {
+    return continuous || pending_frames > 0;
+}
+
+// Seconds to wait for events before the next check
+double RenderScheduler::get_wait_timeout() const {
+    return should_render() ? 0.0 : idle_timeout;
+}
+
+// A frame was drawn
+void RenderScheduler::on_frame_rendered() {
+    if (pending_frames > 0) {
+        pending_frames--;
+    }
+    frames_rendered++;
+}
+
+// The loop woke up and found nothing to draw
+void RenderScheduler::on_idle_wakeup() {
+    idle_wakeups++;
+}
+
+// Get the number of frames drawn
+uint64_t RenderScheduler::get_frames_rendered() const {
+    return frames_rendered;
+}
+
+// Get the number of wake-ups without a frame
+uint64_t RenderScheduler::get_idle_wakeups() const {
+    return idle_wakeups;
+}
@@ -0,0 +1,69 @@
+#ifndef RENDER_SCHEDULER_H
+#define RENDER_SCHEDULER_H
+
+#include <cstdint>
+
+// Decides when the main loop needs to build and draw a frame
+//
+// Frames are rendered after input, after the task data changes, and for a
+// few extra frames after either so ImGui can settle (popups auto-sizing,
+// hover state, focus changes). While something animates continuously (a
+// mouse button held, an active text field, a live profiler graph) every
+// frame is rendered. Otherwise the loop blocks for up to the idle timeout
+// waiting for events, so an idle window costs almost no CPU.
+//
+// Usage:
+//     scheduler.should_render() ? glfwPollEvents() : glfwWaitEventsTimeout(scheduler.get_wait_timeout());
+//     scheduler.check_generation(task_manager.get_generation());
+//     if (scheduler.should_render()) { ...frame...; scheduler.on_frame_rendered(); }
+class RenderScheduler {
+private:
+    int frames_after_input = 3;             // Extra frames after input or data changes
+    double idle_timeout = 0.5;              // Longest wait without events (seconds)
+
+    int pending_frames = 1;                 // Frames still to render (the first frame is always drawn)
+    bool continuous = false;                // Render every frame
+    uint64_t last_generation = UINT64_MAX;  // Task data generation of the last check
+
+    uint64_t frames_rendered = 0;           // Frames drawn
+    uint64_t idle_wakeups = 0;              // Wake-ups that did not need a frame
+
+public:
+    // Set the number of frames rendered after each input or data change
+    void set_frames_after_input(int frames);
+
+    // Set the longest time to block without events (bounds the latency of data changes)
+    void set_idle_timeout(double seconds);
+
+    // Input arrived (mouse, keyboard, focus, resize, expose)
+    void on_input();
+
+    // Request a single frame
+    void request_frame();
+
+    // Schedule frames when the task data generation changed since the last call
+    void check_generation(uint64_t generation);
+
+    // Render every frame while `value` is true (animations)
+    void set_continuous(bool value);
+
+    // Check if a frame should be drawn now
+    bool should_render() const;
+
+    // Seconds to wait for events before the next check (0 = do not block)
+    double get_wait_timeout() const;
+
+    // A frame was drawn
+    void on_frame_rendered();
+
+    // The loop woke up and found nothing to draw
+    void on_idle_wakeup();
+
+    // Number of frames drawn
+    uint64_t get_frames_rendered() const;
+
+    // Number of wake-ups without a frame
+    uint64_t get_idle_wakeups() const;
+};
+
+#endif
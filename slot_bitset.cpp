@@ -0,0 +1,135 @@
+#include <algorithm>
+#include "slot_bitset.h"
+
+// Grow the word array to cover `slot`
+void SlotBitset::grow_to(uint32_t slot) {
+    size_t needed = static_cast<size_t>(slot) / 64 + 1;
+    if (needed > words.size()) {
+        words.resize(std::max(needed, words.size() * 2), 0);  // Amortized growth while tasks are added
+    }
+}
+
+// Grow the word array to cover another set
+void SlotBitset::grow_to(const SlotBitset& other) {
+    if (other.words.size() > words.size()) {
+        words.resize(other.words.size(), 0);
+    }
+}
+
+// Count set bits in the words from `first` on
+size_t SlotBitset::count_from(size_t first) const {
+    size_t total = 0;
+    for (size_t i = first; i < words.size(); i++) {
+        total += static_cast<size_t>(std::popcount(words[i]));
+    }
+    return total;
+}
+
+// Set one bit
+void SlotBitset::set(uint32_t slot) {
+    grow_to(slot);
+    uint64_t& word = words[slot / 64];
+    uint64_t bit = uint64_t{1} << (slot % 64);
+    count += (word & bit) == 0;
+    word |= bit;
+}
+
+// Clear one bit
+void SlotBitset::reset(uint32_t slot) {
+    size_t index = slot / 64;
+    if (index >= words.size()) {
+        return;  // Never set
+    }
+    uint64_t bit = uint64_t{1} << (slot % 64);
+    count -= (words[index] & bit) != 0;
+    words[index] &= ~bit;
+}
+
+// Set or clear one bit
+void SlotBitset::assign(uint32_t slot, bool value) {
+    if (value) {
+        set(slot);
+    } else {
+        reset(slot);
+    }
+}
+
+// Flip one bit
+bool SlotBitset::flip(uint32_t slot) {
+    grow_to(slot);
+    uint64_t& word = words[slot / 64];
+    uint64_t bit = uint64_t{1} << (slot % 64);
+    word ^= bit;
+    bool value = (word & bit) != 0;
+    count = value ? count + 1 : count - 1;
+    return value;
+}
+
+// Clear all bits
+void SlotBitset::clear() {
+    std::fill(words.begin(), words.end(), 0);
+    count = 0;
+}
+
+// Copy the bits of another set
+void SlotBitset::copy_from(const SlotBitset& other) {
+    grow_to(other);
+    std::copy(other.words.begin(), other.words.end(), words.begin());
+    std::fill(words.begin() + other.words.size(), words.end(), 0);
+    count = other.count;
+}
+
+// this |= other
+void SlotBitset::merge(const SlotBitset& other) {
+    grow_to(other);
+    size_t total = 0;
+    for (size_t i = 0; i < other.words.size(); i++) {
+        words[i] |= other.words[i];
+        total += static_cast<size_t>(std::popcount(words[i]));
+    }
+    count = total + count_from(other.words.size());
+}
+
+// this |= include & ~exclude
+void SlotBitset::merge_difference(const SlotBitset& include, const SlotBitset& exclude) {
+    grow_to(include);
+    size_t total = 0;
+    for (size_t i = 0; i < include.words.size(); i++) {
+        uint64_t excluded = i < exclude.words.size() ? exclude.words[i] : 0;
+        words[i] |= include.words[i] & ~excluded;
+        total += static_cast<size_t>(std::popcount(words[i]));
+    }
+    count = total + count_from(include.words.size());
+}
+
+// this ^= mask
+void SlotBitset::flip_masked(const SlotBitset& mask) {
+    grow_to(mask);
+    size_t total = 0;
+    for (size_t i = 0; i < mask.words.size(); i++) {
+        words[i] ^= mask.words[i];
+        total += static_cast<size_t>(std::popcount(words[i]));
+    }
+    count = total + count_from(mask.words.size());
+}
+
+// this &= mask
+void SlotBitset::intersect(const SlotBitset& mask) {
+    size_t total = 0;
+    for (size_t i = 0; i < words.size(); i++) {
+        words[i] &= i < mask.words.size() ? mask.words[i] : 0;
+        total += static_cast<size_t>(std::popcount(words[i]));
+    }
+    count = total;
+}
+
+// this &= ~mask
+void SlotBitset::subtract(const SlotBitset& mask) {
+    size_t shared = std::min(words.size(), mask.words.size());
+    size_t total = 0;
+    for (size_t i = 0; i < shared; i++) {
+        words[i] &= ~mask.words[i];
+        total += static_cast<size_t>(std::popcount(words[i]));
+    }
+    count = total + count_from(shared);
+}
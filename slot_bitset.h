@@ -0,0 +1,90 @@
+#ifndef SLOT_BITSET_H
+#define SLOT_BITSET_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <bit>
+
+// Dense bitset indexed by slot, with a maintained count of set bits
+//
+// Single-bit updates are O(1) and keep the count current, so "any bit set"
+// and "how many" are O(1). Whole-set operations work on 64 slots per step.
+// The set grows on demand; bits past the end read as clear.
+class SlotBitset {
+private:
+    std::vector<uint64_t> words;    // Bit `slot % 64` of word `slot / 64`
+    size_t count = 0;               // Number of set bits
+
+    // Make room for `slot`
+    void grow_to(uint32_t slot);
+
+    // Make room for every slot of `other`
+    void grow_to(const SlotBitset& other);
+
+    // Count the set bits in words[first..] (the part a whole-set operation did not touch)
+    size_t count_from(size_t first) const;
+
+public:
+    // Set one bit
+    void set(uint32_t slot);
+
+    // Clear one bit
+    void reset(uint32_t slot);
+
+    // Set or clear one bit
+    void assign(uint32_t slot, bool value);
+
+    // Flip one bit; returns its new value
+    bool flip(uint32_t slot);
+
+    // Check one bit
+    bool test(uint32_t slot) const {
+        size_t word = slot / 64;
+        return word < words.size() && (words[word] >> (slot % 64)) & 1u;
+    }
+
+    // Number of set bits (O(1))
+    size_t get_count() const { return count; }
+
+    // Check if any bit is set (O(1))
+    bool any() const { return count != 0; }
+
+    // Clear every bit, keeping the storage
+    void clear();
+
+    // Make this set equal to `other`
+    void copy_from(const SlotBitset& other);
+
+    // Set every bit that is set in `other`
+    void merge(const SlotBitset& other);
+
+    // Set every bit that is set in `include` and clear in `exclude`
+    void merge_difference(const SlotBitset& include, const SlotBitset& exclude);
+
+    // Flip every bit that is set in `mask`
+    void flip_masked(const SlotBitset& mask);
+
+    // Clear every bit that is clear in `mask`
+    void intersect(const SlotBitset& mask);
+
+    // Clear every bit that is set in `mask`
+    void subtract(const SlotBitset& mask);
+
+    // Call `visit(slot)` for every set bit in increasing slot order
+    template <typename Visit>
+    void for_each_set(Visit&& visit) const {
+        for (size_t word = 0; word < words.size(); word++) {
+            uint64_t bits = words[word];
+            while (bits != 0) {
+                visit(static_cast<uint32_t>(word * 64 + std::countr_zero(bits)));
+                bits &= bits - 1;  // Clear the lowest set bit
+            }
+        }
+    }
+
+    // Bytes used by the bit storage
+    size_t get_memory_bytes() const { return words.capacity() * sizeof(uint64_t); }
+};
+
+#endif
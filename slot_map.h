@@ -0,0 +1,163 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+
+// Stable reference to a value stored in a SlotMap
+// `index` names the slot, `generation` must match the slot's current
+// generation, so handles to erased (or erased and reused) slots are rejected.
+struct SlotHandle {
+    uint32_t index = UINT32_MAX;        // Slot index
+    uint32_t generation = 0;            // Slot generation when the handle was issued
+
+    bool operator==(const SlotHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const SlotHandle& other) const { return !(*this == other); }
+
+    // Check if the handle was ever issued (a null handle never resolves)
+    bool is_null() const { return index == UINT32_MAX; }
+
+    // Pack into a single 64-bit key
+    uint64_t packed() const { return (static_cast<uint64_t>(generation) << 32) | index; }
+};
+
+// Dense storage with stable handles
+//
+// Values are packed contiguously in insertion order (erase moves the last
+// value into the hole), so full scans walk a flat array. Slots map handles
+// to dense positions; a slot's generation is odd while it is occupied and
+// is bumped on every insert and erase.
+template <typename T>
+class SlotMap {
+private:
+    // Indirection entry for one handle index
+    struct Slot {
+        uint32_t dense_index = 0;       // Position in `values` (next free slot while free)
+        uint32_t generation = 0;        // Odd = occupied, even = free
+    };
+
+    std::vector<T> values;              // Packed values
+    std::vector<uint32_t> dense_slots;  // Slot index of each packed value
+    std::vector<Slot> slots;            // Slot table
+    uint32_t free_head = UINT32_MAX;    // First free slot (singly linked through dense_index)
+
+public:
+    // Insert a value and return its handle
+    SlotHandle insert(T value) {
+        uint32_t slot_index;
+        if (free_head != UINT32_MAX) {
+            slot_index = free_head;                     // Reuse a freed slot
+            free_head = slots[slot_index].dense_index;
+        } else {
+            slot_index = static_cast<uint32_t>(slots.size());
+            slots.push_back(Slot{});
+        }
+
+        Slot& slot = slots[slot_index];
+        slot.dense_index = static_cast<uint32_t>(values.size());
+        slot.generation++;                              // Becomes odd: occupied
+
+        values.push_back(std::move(value));
+        dense_slots.push_back(slot_index);
+        return SlotHandle{slot_index, slot.generation};
+    }
+
+    // Erase the value behind a handle; returns false for stale handles
+    bool erase(SlotHandle handle) {
+        if (!contains(handle)) {
+            return false;
+        }
+
+        Slot& slot = slots[handle.index];
+        uint32_t hole = slot.dense_index;
+        uint32_t last = static_cast<uint32_t>(values.size() - 1);
+
+        // Keep values packed: move the last value into the hole
+        if (hole != last) {
+            values[hole] = std::move(values[last]);
+            dense_slots[hole] = dense_slots[last];
+            slots[dense_slots[hole]].dense_index = hole;
+        }
+        values.pop_back();
+        dense_slots.pop_back();
+
+        slot.generation++;                              // Becomes even: free, old handles go stale
+        slot.dense_index = free_head;
+        free_head = handle.index;
+        return true;
+    }
+
+    // Check if a handle refers to a live value
+    bool contains(SlotHandle handle) const {
+        return handle.index < slots.size() && slots[handle.index].generation == handle.generation &&
+               (handle.generation & 1u) != 0;
+    }
+
+    // Resolve a handle (nullptr if stale)
+    T* get(SlotHandle handle) {
+        return contains(handle) ? &values[slots[handle.index].dense_index] : nullptr;
+    }
+
+    const T* get(SlotHandle handle) const {
+        return contains(handle) ? &values[slots[handle.index].dense_index] : nullptr;
+    }
+
+    // Value of an occupied slot by slot index (no generation check)
+    T& at_slot(uint32_t slot_index) { return values[slots[slot_index].dense_index]; }
+    const T& at_slot(uint32_t slot_index) const { return values[slots[slot_index].dense_index]; }
+
+    // Current handle of an occupied slot
+    SlotHandle handle_of_slot(uint32_t slot_index) const {
+        return SlotHandle{slot_index, slots[slot_index].generation};
+    }
+
+    // Handle of the value at a packed position
+    SlotHandle handle_at(size_t dense_index) const {
+        return handle_of_slot(dense_slots[dense_index]);
+    }
+
+    // Slot index of the value at a packed position
+    uint32_t slot_at(size_t dense_index) const {
+        return dense_slots[dense_index];
+    }
+
+    // Check if a slot index is currently occupied
+    bool slot_occupied(uint32_t slot_index) const {
+        return slot_index < slots.size() && (slots[slot_index].generation & 1u) != 0;
+    }
+
+    // Number of slots ever allocated (upper bound for slot indices)
+    size_t slot_capacity() const { return slots.size(); }
+
+    // Number of stored values
+    size_t size() const { return values.size(); }
+
+    // Check if there are no values
+    bool empty() const { return values.empty(); }
+
+    // Packed values (contiguous, order changes on erase)
+    const std::vector<T>& dense_values() const { return values; }
+
+    // Reserve room for `count` values
+    void reserve(size_t count) {
+        values.reserve(count);
+        dense_slots.reserve(count);
+        slots.reserve(count);
+    }
+
+    // Remove all values; generations keep counting so old handles stay stale
+    void clear() {
+        for (uint32_t slot_index : dense_slots) {
+            Slot& slot = slots[slot_index];
+            slot.generation++;
+            slot.dense_index = free_head;
+            free_head = slot_index;
+        }
+        values.clear();
+        dense_slots.clear();
+    }
+};
+
+#endif
@@ -1,9 +1,10 @@
+#include <utility>
 #include "task.h"
 
 // Task constructor implementation
 // Initializes a task with the provided ID, title, and completion status
-Task::Task(const std::string& task_id, const std::string& task_title, bool task_done)
-    : id(task_id),        // Initialize task ID
-      title(task_title),  // Initialize task title/description
+Task::Task(const TaskId& task_id, std::string task_title, bool task_done)
+    : id(task_id),                    // Initialize task ID
+      title(std::move(task_title)),   // Take over the title/description
       done(task_done)     // Initialize completion status
 {}
\ No newline at end of file
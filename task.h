@@ -2,16 +2,18 @@
 #define TASK_H
 
 #include <string>
+#include "task_id.h"
 
 // Task structure representing a single todo item
 struct Task {
-    std::string id;        // Unique identifier for the task
+    TaskId id;             // Unique identifier for the task (128-bit UUID)
     std::string title;     // Task description or name
     bool done;             // Completion status (true = completed, false = pending)
     
     // Constructor: Creates a new task with specified parameters
     // Default values create an empty/invalid task
-    Task(const std::string& task_id = "", const std::string& task_title = "", bool task_done = false);
+    // The title is taken by value, so callers can move a string in without a copy
+    Task(const TaskId& task_id = TaskId(), std::string task_title = "", bool task_done = false);
 };
 
 #endif
\ No newline at end of file
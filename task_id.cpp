@@ -0,0 +1,87 @@
+#include "task_id.h"
+
+// Value of a hex digit, or -1
+static int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Parse "XXXXXXXX-XXXX-XXXX-XXXX-XXXXXXXXXXXX"
+bool TaskId::parse(const std::string& text, TaskId& out) {
+    if (text.size() != 36) {
+        return false;
+    }
+
+    uint64_t words[2] = {0, 0};
+    int digits = 0;
+    for (size_t i = 0; i < text.size(); i++) {
+        if (i == 8 || i == 13 || i == 18 || i == 23) {
+            if (text[i] != '-') {
+                return false;
+            }
+            continue;
+        }
+
+        int value = hex_value(text[i]);
+        if (value < 0) {
+            return false;
+        }
+        uint64_t& word = words[digits / 16];
+        word = (word << 4) | static_cast<uint64_t>(value);
+        digits++;
+    }
+
+    out.high = words[0];
+    out.low = words[1];
+    return true;
+}
+
+// Convert an id from disk, keeping legacy non-UUID ids stable across loads
+TaskId TaskId::from_text(const std::string& text) {
+    TaskId id;
+    if (text.empty() || parse(text, id)) {
+        return id;
+    }
+
+    // Two independent FNV-1a passes give 128 bits that depend only on the bytes,
+    // so the same legacy id maps to the same TaskId in snapshot and journal
+    uint64_t a = 0xCBF29CE484222325ull;
+    uint64_t b = 0x84222325CBF29CE4ull;
+    for (unsigned char c : text) {
+        a = (a ^ c) * 0x100000001B3ull;
+        b = (b ^ c) * 0x100000001B3ull;
+        b ^= b >> 29;
+    }
+
+    // Mark as a version 8 (custom) UUID so these never look like generated ids
+    id.high = (a & ~0xF000ull) | 0x8000ull;
+    id.low = (b & ~(0x3ull << 62)) | (0x2ull << 62);
+    return id;
+}
+
+// Format as uppercase 8-4-4-4-12
+std::string TaskId::to_string() const {
+    std::string text;
+    text.reserve(36);
+    append_to(text);
+    return text;
+}
+
+// Append the text form
+void TaskId::append_to(std::string& out) const {
+    static const char hex_digits[] = "0123456789ABCDEF";
+
+    char buffer[36];
+    size_t position = 0;
+    for (int digit = 0; digit < 32; digit++) {
+        if (digit == 8 || digit == 12 || digit == 16 || digit == 20) {
+            buffer[position++] = '-';
+        }
+        uint64_t word = digit < 16 ? high : low;
+        int shift = 60 - 4 * (digit % 16);
+        buffer[position++] = hex_digits[(word >> shift) & 0xF];
+    }
+    out.append(buffer, sizeof(buffer));
+}
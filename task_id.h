@@ -0,0 +1,54 @@
+#ifndef TASK_ID_H
+#define TASK_ID_H
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+
+// 128-bit task identifier stored as two integers
+// Text form is the canonical UUID layout (8-4-4-4-12 uppercase hex); it is
+// only produced when ids are written to disk or shown, everything else
+// compares and hashes the two words directly.
+struct TaskId {
+    uint64_t high = 0;   // First 16 hex digits of the text form
+    uint64_t low = 0;    // Last 16 hex digits of the text form
+
+    bool operator==(const TaskId& other) const { return high == other.high && low == other.low; }
+    bool operator!=(const TaskId& other) const { return !(*this == other); }
+    bool operator<(const TaskId& other) const { return high != other.high ? high < other.high : low < other.low; }
+
+    // Check if this is the all-zero id (used for "no task")
+    bool is_nil() const { return high == 0 && low == 0; }
+
+    // Hash suitable for unordered containers
+    size_t hash() const {
+        uint64_t h = high ^ (low * 0x9E3779B97F4A7C15ull);
+        h ^= h >> 32;
+        h *= 0xD6E8FEB86659FD93ull;
+        h ^= h >> 32;
+        return static_cast<size_t>(h);
+    }
+
+    // Parse the canonical 36-character form (hex digits in either case)
+    // Returns false if `text` is not a well-formed UUID
+    static bool parse(const std::string& text, TaskId& out);
+
+    // Convert an id read from disk: UUID text parses exactly, any other
+    // (legacy) string maps to a stable id derived from its bytes
+    static TaskId from_text(const std::string& text);
+
+    // Canonical text form
+    std::string to_string() const;
+
+    // Append the canonical text form to `out` without a temporary string
+    void append_to(std::string& out) const;
+};
+
+// Allow TaskId as an unordered container key
+template <>
+struct std::hash<TaskId> {
+    size_t operator()(const TaskId& id) const { return id.hash(); }
+};
+
+#endif
@@ -0,0 +1,234 @@
+#include <iostream>
+#include <filesystem>
+#include <iterator>
+#include "task_journal.h"
+#include "task_storage.h"
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+// Constructor: Remembers the journal path and picks up the size of an existing log
+TaskJournal::TaskJournal(const std::string& journal_path) : path(journal_path) {
+    std::error_code ec;
+    if (std::filesystem::exists(path, ec)) {
+        size = std::filesystem::file_size(path, ec);  // Continue appending after existing records
+    }
+}
+
+// Open the journal for appending on first use
+bool TaskJournal::ensure_open() {
+    if (out.is_open()) {
+        return true;
+    }
+
+    out.open(path, std::ios::out | std::ios::app | std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "Error: Cannot open journal file " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Encode one mutation record as a compact JSON line
+// Written by hand with the snapshot writer's string escaping, so titles with
+// invalid UTF-8 are stored with U+FFFD instead of throwing (json::dump() does)
+std::string TaskJournal::encode(const JournalRecord& record) {
+    std::string line;
+    line.reserve(96 + record.title.size());
+    if (record.op != JournalRecord::Op::Delete) {
+        line.append(record.done ? "{\"done\":true," : "{\"done\":false,");
+    } else {
+        line.push_back('{');
+    }
+    line.append("\"id\":\"");
+    record.id.append_to(line);  // Hex and dashes, never needs escaping
+    switch (record.op) {
+        case JournalRecord::Op::Add:
+            line.append("\",\"op\":\"add\",\"title\":");
+            append_json_string(line, record.title);
+            line.append("}\n");
+            break;
+        case JournalRecord::Op::Delete:
+            line.append("\",\"op\":\"del\"}\n");
+            break;
+        case JournalRecord::Op::SetDone:
+            line.append("\",\"op\":\"set\"}\n");
+            break;
+    }
+    return line;
+}
+
+// Write already encoded lines and flush them to disk
+bool TaskJournal::write_lines(const std::string& lines) {
+    if (!ensure_open()) {
+        return false;
+    }
+
+    out.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+    out.flush();  // Make the records durable before returning to the caller
+
+    if (!out.good()) {
+        std::cerr << "Error: Failed to append to journal " << path << std::endl;
+        out.close();  // Reopen on the next append
+        return false;
+    }
+
+    size += lines.size();
+    return true;
+}
+
+// Append one mutation record
+bool TaskJournal::append(const JournalRecord& record) {
+    return write_lines(encode(record));
+}
+
+// Append a batch of mutation records with a single flush
+bool TaskJournal::append(const std::vector<JournalRecord>& records) {
+    if (records.empty()) {
+        return true;
+    }
+
+    std::string lines;
+    for (const JournalRecord& record : records) {
+        lines += encode(record);
+    }
+    return write_lines(lines);
+}
+
+// Read and decode all records from the journal file
+std::vector<JournalRecord> TaskJournal::read_all() const {
+    std::vector<JournalRecord> records;
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return records;  // No journal yet
+    }
+
+    std::string line;
+    size_t line_number = 0;
+    while (std::getline(file, line)) {
+        line_number++;
+        if (line.empty()) {
+            continue;
+        }
+
+        // Parse without exceptions; a torn write leaves an invalid last line
+        json j = json::parse(line, nullptr, false);
+        if (j.is_discarded() || !j.is_object() || !j.contains("op") || !j.contains("id")) {
+            std::cerr << "Warning: Skipping invalid journal record at line " << line_number << std::endl;
+            continue;
+        }
+
+        try {
+            JournalRecord record;
+            const std::string op = j["op"];
+            record.id = TaskId::from_text(j["id"].get<std::string>());  // Legacy ids map like in the snapshot
+
+            if (op == "add") {
+                record.op = JournalRecord::Op::Add;
+                record.title = j.value("title", "");
+                record.done = j.value("done", false);
+            } else if (op == "del") {
+                record.op = JournalRecord::Op::Delete;
+            } else if (op == "set") {
+                record.op = JournalRecord::Op::SetDone;
+                record.done = j.value("done", false);
+            } else {
+                std::cerr << "Warning: Unknown journal operation '" << op << "' at line " << line_number << std::endl;
+                continue;
+            }
+
+            records.push_back(std::move(record));
+        } catch (const json::exception& e) {
+            std::cerr << "Warning: Skipping journal record at line " << line_number << " - invalid data: " << e.what() << std::endl;
+        }
+    }
+
+    return records;
+}
+
+// Truncate the journal (called once its records are part of a snapshot)
+void TaskJournal::clear() {
+    if (out.is_open()) {
+        out.close();
+    }
+
+    std::ofstream truncate(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!truncate.is_open()) {
+        std::cerr << "Error: Cannot truncate journal file " << path << std::endl;
+        return;
+    }
+    size = 0;
+}
+
+// Remove the records covered by a snapshot and keep the newer tail
+void TaskJournal::discard_prefix(std::uintmax_t bytes) {
+    if (bytes == 0) {
+        return;
+    }
+    if (bytes >= size) {
+        clear();  // Snapshot covers every record
+        return;
+    }
+
+    if (out.is_open()) {
+        out.close();
+    }
+
+    // Read the tail that was appended after the snapshot was taken
+    std::string tail;
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Error: Cannot read journal file " << path << std::endl;
+            return;
+        }
+        file.seekg(static_cast<std::streamoff>(bytes));
+        tail.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        if (file.bad() || tail.size() != size - bytes) {
+            std::cerr << "Error: Cannot read journal file " << path << std::endl;
+            return;
+        }
+    }
+
+    // Write the tail next to the journal and swap it in, so a failure at any
+    // point leaves the old journal in place (replaying it again is harmless:
+    // every record sets a state rather than changing it)
+    const std::string temp_path = path + ".tmp";
+    std::ofstream rewrite(temp_path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!rewrite.is_open()) {
+        std::cerr << "Error: Cannot create journal file " << temp_path << std::endl;
+        return;
+    }
+    rewrite.write(tail.data(), static_cast<std::streamsize>(tail.size()));
+    rewrite.close();
+
+    std::error_code ec;
+    if (rewrite.fail() || !sync_file(temp_path)) {
+        std::cerr << "Error: Failed to write journal file " << temp_path << std::endl;
+        std::filesystem::remove(temp_path, ec);
+        return;
+    }
+    std::filesystem::rename(temp_path, path, ec);
+    if (ec) {
+        std::cerr << "Error: Cannot replace journal file " << path << ": " << ec.message() << std::endl;
+        std::filesystem::remove(temp_path, ec);
+        return;
+    }
+    size = tail.size();
+}
+
+// Get journal size in bytes
+std::uintmax_t TaskJournal::size_bytes() const {
+    return size;
+}
+
+// Check if the journal is empty
+bool TaskJournal::is_empty() const {
+    return size == 0;
+}
+
+// Get journal file path
+const std::string& TaskJournal::get_path() const {
+    return path;
+}
@@ -0,0 +1,83 @@
+#ifndef TASK_JOURNAL_H
+#define TASK_JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+#include "task_id.h"
+
+// Single task mutation as stored in the write-ahead journal
+struct JournalRecord {
+    // Kind of mutation recorded
+    enum class Op {
+        Add,      // New task inserted (id, title, done)
+        Delete,   // Task removed (id)
+        SetDone   // Completion status changed (id, done)
+    };
+
+    Op op = Op::Add;        // Mutation type
+    TaskId id;              // Identifier of the affected task
+    std::string title;      // Task title (Add only)
+    bool done = false;      // Resulting completion status (Add and SetDone)
+};
+
+// Append-only log of task mutations kept next to the snapshot file.
+// Each record is one compact JSON object per line, so appending a mutation
+// costs a few dozen bytes instead of a full snapshot rewrite.
+class TaskJournal {
+private:
+    // Path of the journal file on disk
+    std::string path;
+
+    // Output stream kept open in append mode between mutations
+    std::ofstream out;
+
+    // Current journal size in bytes (used to trigger compaction)
+    std::uintmax_t size = 0;
+
+    // Open the output stream in append mode if it is not open yet
+    bool ensure_open();
+
+    // Encode a record as one compact JSON line (including the newline)
+    static std::string encode(const JournalRecord& record);
+
+    // Write encoded lines and flush them in one go
+    bool write_lines(const std::string& lines);
+
+public:
+    // Constructor: Binds the journal to a file path (file is opened lazily)
+    explicit TaskJournal(const std::string& journal_path);
+
+    // Append a record and flush it to disk
+    // Returns false if the record could not be written
+    bool append(const JournalRecord& record);
+
+    // Append several records with a single write and flush
+    // Returns false if the records could not be written
+    bool append(const std::vector<JournalRecord>& records);
+
+    // Read every valid record from the journal in order
+    // A torn trailing line (e.g. after a crash) is skipped with a warning
+    std::vector<JournalRecord> read_all() const;
+
+    // Truncate the journal after its records were folded into a snapshot
+    void clear();
+
+    // Drop the first `bytes` bytes of the journal, keeping records appended after them
+    // Used when a snapshot was taken while new records kept arriving. The tail is
+    // written to a temporary file and renamed over the journal; if that fails
+    // the journal is left whole.
+    void discard_prefix(std::uintmax_t bytes);
+
+    // Size of the journal in bytes
+    std::uintmax_t size_bytes() const;
+
+    // Check if the journal holds no records
+    bool is_empty() const;
+
+    // Path of the journal file
+    const std::string& get_path() const;
+};
+
+#endif
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include "imgui.h"
+#include "task_list_layout.h"
+
+// Build the Fenwick tree from plain heights in O(n)
+void RowHeightTree::reset(const std::vector<float>& heights) {
+    const size_t count = heights.size();
+    tree.assign(count + 1, 0.0);
+    total = 0.0;
+
+    for (size_t i = 1; i <= count; i++) {
+        tree[i] += heights[i - 1];
+        total += heights[i - 1];
+
+        size_t parent = i + (i & (~i + 1));  // i + lowest set bit
+        if (parent <= count) {
+            tree[parent] += tree[i];
+        }
+    }
+}
+
+// Point update
+void RowHeightTree::add(size_t index, double delta) {
+    total += delta;
+    for (size_t i = index + 1; i < tree.size(); i += i & (~i + 1)) {
+        tree[i] += delta;
+    }
+}
+
+// Prefix sum of rows before `index`
+double RowHeightTree::prefix(size_t index) const {
+    if (tree.empty()) {
+        return 0.0;
+    }
+
+    double sum = 0.0;
+    for (size_t i = std::min(index, tree.size() - 1); i > 0; i -= i & (~i + 1)) {
+        sum += tree[i];
+    }
+    return sum;
+}
+
+// Binary search down the tree for the row containing `offset`
+size_t RowHeightTree::find(double offset) const {
+    const size_t count = size();
+    if (count == 0) {
+        return 0;
+    }
+
+    size_t position = 0;    // Number of rows that end at or before `offset`
+    size_t step = 1;
+    while (step * 2 <= count) {
+        step *= 2;
+    }
+
+    for (; step > 0; step /= 2) {
+        size_t next = position + step;
+        if (next <= count && tree[next] <= offset) {
+            position = next;
+            offset -= tree[next];
+        }
+    }
+    return std::min(position, count - 1);
+}
+
+// Get total height
+double RowHeightTree::get_total() const {
+    return total;
+}
+
+// Get number of rows
+size_t RowHeightTree::size() const {
+    return tree.empty() ? 0 : tree.size() - 1;
+}
+
+// Recompute row heights from the cache after the rows or width changed
+void TaskListLayout::rebuild(uint64_t rows_version, float wrap_width, float estimated_height) {
+    const size_t count = rows->size();
+    heights.assign(count, estimated_height);
+
+    // The estimate follows the font and style, so heights measured under another one are stale
+    if (estimated_height != built_estimate) {
+        height_cache.assign(height_cache.size(), CachedHeight{});
+    }
+    measured.assign(count, 0);
+
+    // Size the cache for every slot now, so record_height() never allocates while drawing
+    uint32_t max_slot = 0;
+    for (size_t i = 0; i < count; i++) {
+        max_slot = std::max(max_slot, (*rows)[i].handle.index);
+    }
+    if (count > 0 && max_slot >= height_cache.size()) {
+        height_cache.resize(static_cast<size_t>(max_slot) + 1);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        TaskHandle handle = (*rows)[i].handle;
+        const CachedHeight& cached = height_cache[handle.index];
+        if (cached.generation == handle.generation && cached.wrap_width == wrap_width) {
+            heights[i] = cached.height;  // Same task, still valid at this width
+            measured[i] = 1;
+        }
+    }
+
+    offsets.reset(heights);
+
+    built_rows_version = rows_version;
+    built_wrap_width = wrap_width;
+    built_estimate = estimated_height;
+}
+
+// Position the cursor at the first row intersecting the viewport
+size_t TaskListLayout::begin(const std::vector<TaskViewModel::Row>& list_rows, uint64_t rows_version, float estimated_height) {
+    rows = &list_rows;
+
+    float wrap_width = ImGui::GetContentRegionAvail().x;
+    if (rows_version != built_rows_version || wrap_width != built_wrap_width ||
+        estimated_height != built_estimate || list_rows.size() != heights.size()) {
+        rebuild(rows_version, wrap_width, estimated_height);
+    }
+
+    start_y = ImGui::GetCursorPosY();
+    float scroll_y = ImGui::GetScrollY();
+    visible_bottom = scroll_y + ImGui::GetWindowHeight();
+
+    if (list_rows.empty()) {
+        return 0;
+    }
+
+    // First row whose span reaches into the viewport
+    double top = std::max(0.0, static_cast<double>(scroll_y - start_y));
+    size_t first = offsets.find(top);
+
+    ImGui::SetCursorPosY(start_y + static_cast<float>(offsets.prefix(first)));
+    return first;
+}
+
+// Check if the next row would still be visible
+bool TaskListLayout::in_view() const {
+    return ImGui::GetCursorPosY() < visible_bottom;
+}
+
+// Update the height of a row that was just drawn
+void TaskListLayout::record_height(size_t index, float height) {
+    if (index >= heights.size()) {
+        return;
+    }
+    if (measured[index] && heights[index] == height) {
+        return;  // Steady state: nothing to update
+    }
+
+    offsets.add(index, static_cast<double>(height) - heights[index]);
+    heights[index] = height;
+    measured[index] = 1;
+    TaskHandle handle = (*rows)[index].handle;
+    if (handle.index >= height_cache.size()) {
+        height_cache.resize(handle.index + 1);
+    }
+    height_cache[handle.index] = CachedHeight{handle.generation, built_wrap_width, height};
+}
+
+// Get the cached height of a row
+float TaskListLayout::get_measured_height(size_t index) const {
+    return index < heights.size() && measured[index] ? heights[index] : 0.0f;
+}
+
+// Get where a row starts in the list
+float TaskListLayout::get_row_y(size_t index) const {
+    return start_y + static_cast<float>(offsets.prefix(index));
+}
+
+// Reserve space for all rows so the scrollbar covers the full list
+void TaskListLayout::end() {
+    float list_end = start_y + static_cast<float>(offsets.get_total());
+    if (ImGui::GetCursorPosY() < list_end) {
+        ImGui::SetCursorPosY(list_end);
+    }
+    ImGui::Dummy(ImVec2(0, 0));  // Submit an item so ImGui accepts the extended bounds
+}
@@ -0,0 +1,99 @@
+#ifndef TASK_LIST_LAYOUT_H
+#define TASK_LIST_LAYOUT_H
+
+#include <vector>
+#include <cstdint>
+#include "task_view_model.h"
+
+// Prefix sums over row heights (Fenwick tree)
+// Supports O(log n) height updates, offset queries and offset -> row search.
+class RowHeightTree {
+private:
+    std::vector<double> tree;   // 1-based Fenwick array
+    double total = 0.0;         // Sum of all heights
+
+public:
+    // Rebuild from a list of heights in O(n)
+    void reset(const std::vector<float>& heights);
+
+    // Add `delta` to the height of row `index`
+    void add(size_t index, double delta);
+
+    // Sum of heights of rows [0, index)
+    double prefix(size_t index) const;
+
+    // Index of the row containing vertical offset `offset` (clamped to the last row)
+    size_t find(double offset) const;
+
+    // Sum of all heights
+    double get_total() const;
+
+    // Number of rows
+    size_t size() const;
+};
+
+// Virtualized layout for one scrolling list of wrapped task rows
+//
+// Only rows intersecting the viewport are submitted. Row heights are
+// measured when a row is drawn and cached per task and wrap width; rows that
+// were never drawn use an estimated height. Per-frame cost is
+// O(visible rows * log n), independent of the list length.
+//
+// Usage inside a scrolling child window:
+//     size_t i = layout.begin(rows, view_model.get_rows_version(), estimated_height);
+//     for (; i < rows.size() && layout.in_view(); i++) {
+//         float y = ImGui::GetCursorPosY();
+//         ...draw row i...
+//         layout.record_height(i, ImGui::GetCursorPosY() - y);
+//     }
+//     layout.end();
+class TaskListLayout {
+private:
+    // Measured height of a task's row at a given wrap width
+    struct CachedHeight {
+        uint32_t generation = 0;    // Handle generation the entry belongs to (0 = empty)
+        float wrap_width = 0.0f;
+        float height = 0.0f;
+    };
+
+    // Measured heights indexed by task handle slot; entries of deleted tasks
+    // are ignored by the generation check and overwritten when the slot is reused
+    std::vector<CachedHeight> height_cache;
+
+    std::vector<float> heights;         // Current height of every row (measured or estimated)
+    std::vector<uint8_t> measured;      // 1 if heights[i] was measured at the current width
+    RowHeightTree offsets;              // Prefix sums over heights
+
+    const std::vector<TaskViewModel::Row>* rows = nullptr;  // Rows of the current frame
+    uint64_t built_rows_version = UINT64_MAX; // Rows version the heights belong to
+    float built_wrap_width = -1.0f;           // Content width the heights belong to
+    float built_estimate = 0.0f;              // Estimated height used for unmeasured rows
+
+    float start_y = 0.0f;               // Cursor Y where the list begins
+    float visible_bottom = 0.0f;        // Cursor Y where the viewport ends
+
+    // Rebuild heights after the rows or the wrap width changed
+    void rebuild(uint64_t rows_version, float wrap_width, float estimated_height);
+
+public:
+    // Prepare the list for this frame and move the cursor to the first visible row
+    // Returns the index of the first row to draw
+    size_t begin(const std::vector<TaskViewModel::Row>& list_rows, uint64_t rows_version, float estimated_height);
+
+    // Check if the cursor is still inside the viewport
+    bool in_view() const;
+
+    // Store the measured height of a drawn row
+    void record_height(size_t index, float height);
+
+    // Height recorded for a row at the current width, or 0 if it was not drawn at this width yet
+    float get_measured_height(size_t index) const;
+
+    // Cursor Y of the top of any row, visible or not (between begin() and end())
+    float get_row_y(size_t index) const;
+
+    // Extend the content to the full list height (keeps the scrollbar correct)
+    void end();
+};
+
+#endif
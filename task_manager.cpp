@@ -1,178 +1,579 @@
 #include <iostream>
 #include "task_manager.h"
+#include "frame_profiler.h"
+#include "text_search.h"
 #include <fstream>
 #include <filesystem>
+#include <algorithm>
 
-// Constructor: Initializes TaskManager with data file path
-TaskManager::TaskManager(const std::string& data_file) : filename(data_file) {
-    // Initialize COM for UUID generation (required for CoCreateGuid)
-    HRESULT hr = CoInitializeEx(NULL, COINIT_APARTMENTTHREADED);
-    com_initialized = SUCCEEDED(hr);
-    
-    if (!com_initialized) {
-        std::cerr << "Warning: COM initialization failed. UUID generation may not work." << std::endl;
-    }
-
+// Constructor: Initializes TaskManager with data file path and persistence mode
+TaskManager::TaskManager(const std::string& data_file, PersistenceMode mode)
+    : filename(data_file),
+      persistence_mode(mode),
+      snapshot_format(snapshot_format_for_path(data_file)),
+      journal(data_file + ".log")  // Journal lives next to the snapshot
+{
     load();  // Load tasks from file on initialization
+
+    save_worker = std::thread(&TaskManager::save_worker_loop, this);  // Start background persistence
 }
 
-// Destructor: Saves tasks and cleans up COM
+// Destructor: Drains the save worker and saves tasks
 TaskManager::~TaskManager() {
+    {
+        std::lock_guard<std::mutex> lock(worker_mutex);
+        stop_worker = true;
+    }
+    worker_cv.notify_all();
+    if (save_worker.joinable()) {
+        save_worker.join();  // Waits for an in-flight write to finish
+    }
+
     save();  // Save tasks to file before destruction
+}
 
-    if (com_initialized) {
-        CoUninitialize();  // Clean up COM
+// Load tasks from JSON snapshot and replay pending journal records
+void TaskManager::load() {
+    PROFILE_SCOPE("TaskManager::load");
+    std::lock_guard<std::mutex> lock(tasks_mutex);  // Keep the save worker out while reloading
+    if (snapshot_copying) {
+        snapshot_aborted = true;  // The half-copied snapshot no longer matches any state
     }
+    tasks.clear();  // Clear existing tasks (handles taken before stay stale)
+    id_index.clear();
+    uncompleted_index.clear();
+    completed_index.clear();
+    ordered_index.clear();
+    title_index.clear();
+    title_column.clear();
+    live_slots.clear();
+    completed_slots.clear();
+    selected_slots.clear();
+    generation++;
+
+    load_snapshot();
+    replay_journal();
 }
 
-// Load tasks from JSON file
-void TaskManager::load() {
-    tasks.clear();  // Clear existing tasks
+// Load tasks from the snapshot file (JSON or binary, detected from its signature)
+void TaskManager::load_snapshot() {
+    std::vector<Task> loaded;
+    SnapshotStatus status = read_snapshot(filename, loaded);
 
-    // Create data file if it doesn't exist
-    if (!std::filesystem::exists(filename)) {
-        std::ofstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "Error: Cannot create data file " << filename << std::endl;
+    switch (status) {
+        case SnapshotStatus::Ok:
+            break;
+        case SnapshotStatus::Missing:
+            // Create data file if it doesn't exist
+            if (!write_snapshot_file(filename, {}, snapshot_format)) {
+                std::cerr << "Error: Cannot create data file " << filename << std::endl;
+            }
+            return;
+        case SnapshotStatus::Empty:
+            std::cerr << "Warning: Data file is empty, creating new one" << std::endl;
+            write_snapshot_file(filename, {}, snapshot_format);  // Create valid empty snapshot
+            return;
+        case SnapshotStatus::Invalid:
+            std::cerr << "Creating new data file..." << std::endl;
+            write_snapshot_file(filename, {}, snapshot_format);  // Reset file with valid snapshot
+            return;
+        case SnapshotStatus::Error:
             return;
+    }
+
+    tasks.reserve(loaded.size());
+    id_index.reserve(loaded.size());
+    for (Task& task : loaded) {
+        upsert_task(std::move(task));
+    }
+}
+
+// Replay journaled mutations that were not yet compacted into the snapshot
+void TaskManager::replay_journal() {
+    if (journal.is_empty()) {
+        return;
+    }
+
+    std::vector<JournalRecord> records = journal.read_all();
+    for (JournalRecord& record : records) {
+        apply_record(record);  // Moves the titles out of the records
+    }
+}
+
+// Apply a journal record to the in-memory tasks
+void TaskManager::apply_record(JournalRecord& record) {
+    switch (record.op) {
+        case JournalRecord::Op::Add:
+            upsert_task(Task(record.id, std::move(record.title), record.done));
+            break;
+        case JournalRecord::Op::Delete:
+            erase_task(record.id);
+            break;
+        case JournalRecord::Op::SetDone: {
+            auto it = id_index.find(record.id);
+            if (it != id_index.end()) {
+                set_task_done(it->second.index, record.done);  // Records store the resulting state, so replay is idempotent
+            }
+            break;
         }
-        file << "{}";  // Write empty JSON object
+    }
+}
+
+// Get the partition index for a completion status
+OrderedTaskIndex& TaskManager::partition_for(bool done) {
+    return done ? completed_index : uncompleted_index;
+}
+
+// Add a slot to its partition
+void TaskManager::partition_add(uint32_t slot) {
+    const Task& task = tasks.at_slot(slot);
+    partition_for(task.done).insert(slot, task.id);
+    live_slots.set(slot);
+    completed_slots.assign(slot, task.done);
+}
+
+// Remove a slot from its partition in O(1) (leaves a tombstone until the next view)
+void TaskManager::partition_remove(uint32_t slot) {
+    partition_for(tasks.at_slot(slot).done).remove(slot);
+    live_slots.reset(slot);
+    completed_slots.reset(slot);
+}
+
+// Insert a task (or replace the one with the same id) and index it
+void TaskManager::upsert_task(Task task) {
+    auto [it, inserted] = id_index.try_emplace(task.id);
+    if (inserted) {
+        it->second = tasks.insert(std::move(task));
+        preserve_for_snapshot(it->second.index, true);
+        ordered_index.insert(it->second.index, it->first);
+    } else {
+        uint32_t slot = it->second.index;
+        preserve_for_snapshot(slot, false);
+        partition_remove(slot);  // Replacing: drop the old partition entry first
+        title_index.remove(slot, tasks.at_slot(slot).title);
+        tasks.at_slot(slot) = std::move(task);
+    }
+    title_index.insert(it->second.index, tasks.at_slot(it->second.index).title);
+    title_column.insert(it->second.index, tasks.at_slot(it->second.index).title);  // Replaces the old title
+    partition_add(it->second.index);
+    generation++;
+}
+
+// Remove a task and its partition entry
+bool TaskManager::erase_task(const TaskId& task_id) {
+    auto it = id_index.find(task_id);
+    if (it == id_index.end()) {
+        return false;
+    }
+    partition_remove(it->second.index);
+    ordered_index.remove(it->second.index);
+    title_index.remove(it->second.index, tasks.at_slot(it->second.index).title);
+    title_column.remove(it->second.index);
+    selected_slots.reset(it->second.index);  // The slot may be reused by another task
+    preserve_for_snapshot(it->second.index, false);
+    tasks.erase(it->second);
+    id_index.erase(it);
+    generation++;
+    return true;
+}
+
+// Update a task's status and move it to the matching partition
+void TaskManager::set_task_done(uint32_t slot, bool done) {
+    Task& task = tasks.at_slot(slot);
+    if (task.done == done) {
+        return;
+    }
+    preserve_for_snapshot(slot, false);
+    partition_remove(slot);
+    task.done = done;
+    partition_add(slot);
+    generation++;
+}
+
+// Save a task the snapshot copy has not reached yet before it changes
+void TaskManager::preserve_for_snapshot(uint32_t slot, bool inserted) {
+    if (!snapshot_copying || slot < snapshot_cursor || slot >= snapshot_slot_end || snapshot_touched.test(slot)) {
+        return;  // Already copied, created after the start, or saved by an earlier change
+    }
+    snapshot_touched.set(slot);
+    if (!inserted) {
+        snapshot_preimages.push_back(tasks.at_slot(slot));
+    }
+}
+
+// Persist a mutation: append to the journal or rewrite the snapshot
+void TaskManager::persist(const JournalRecord& record) {
+    PROFILE_SCOPE("TaskManager::persist");
+    // Inside a batch, defer persistence until commit_batch()
+    if (batch_depth > 0) {
+        pending_records.push_back(record);
+        return;
+    }
+
+    if (persistence_mode == PersistenceMode::Snapshot) {
+        note_mutation(1, true);  // Worker rewrites the snapshot
+        return;
+    }
+
+    // Fall back to a full snapshot if the journal cannot be written,
+    // and fold the journal into a new snapshot once it grows past the threshold
+    bool appended = journal.append(record);
+    note_mutation(1, !appended || journal.size_bytes() >= compaction_threshold);
+}
+
+// Persist records collected during a batch
+void TaskManager::flush_pending() {
+    if (pending_records.empty()) {
+        return;
+    }
+
+    std::vector<JournalRecord> records;
+    records.swap(pending_records);
+
+    if (persistence_mode == PersistenceMode::Snapshot) {
+        note_mutation(records.size(), true);  // One snapshot for the whole batch
         return;
     }
 
-    try {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "Error: Cannot open data file " << filename << std::endl;
+    // Fall back to a full snapshot if the journal cannot be written
+    bool appended = journal.append(records);
+    note_mutation(records.size(), !appended || journal.size_bytes() >= compaction_threshold);
+}
+
+// Record persisted mutations and wake the worker if a snapshot is due
+void TaskManager::note_mutation(size_t count, bool need_snapshot) {
+    {
+        std::lock_guard<std::mutex> lock(worker_mutex);
+        stats.queue_depth += count;
+        if (!need_snapshot) {
             return;
         }
+        snapshot_requested = true;
+    }
+    worker_cv.notify_one();
+}
 
-        // Check if file is empty
-        if (file.peek() == std::ifstream::traits_type::eof()) {
-            std::cerr << "Warning: Data file is empty, creating new one" << std::endl;
-            file.close();
-            std::ofstream new_file(filename);
-            new_file << "{}";  // Create valid empty JSON
+// Begin a batch of mutations
+void TaskManager::begin_batch() {
+    std::lock_guard<std::mutex> lock(tasks_mutex);
+    batch_depth++;
+}
+
+// Commit a batch of mutations (persists once when the outermost batch ends)
+void TaskManager::commit_batch() {
+    PROFILE_SCOPE("TaskManager::commit_batch");
+    std::lock_guard<std::mutex> lock(tasks_mutex);
+    if (batch_depth == 0) {
+        std::cerr << "Warning: commit_batch() called without begin_batch()" << std::endl;
+        return;
+    }
+
+    batch_depth--;
+    if (batch_depth == 0) {
+        flush_pending();
+    }
+}
+
+// Check if a batch is open
+bool TaskManager::in_batch() const {
+    return batch_depth > 0;
+}
+
+// Switch persistence mode
+void TaskManager::set_persistence_mode(PersistenceMode mode) {
+    if (mode == persistence_mode) {
+        return;
+    }
+
+    bool fold_journal = false;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        persistence_mode = mode;
+        fold_journal = mode == PersistenceMode::Snapshot && !journal.is_empty();
+    }
+
+    if (fold_journal) {
+        save();  // Fold outstanding journal records into the snapshot
+    }
+}
+
+// Get active persistence mode
+PersistenceMode TaskManager::get_persistence_mode() const {
+    return persistence_mode;
+}
+
+// Set journal compaction threshold in bytes
+void TaskManager::set_compaction_threshold(std::uintmax_t bytes) {
+    std::lock_guard<std::mutex> lock(tasks_mutex);
+    compaction_threshold = bytes;
+}
+
+// Change the on-disk snapshot format (takes effect with the next snapshot write)
+void TaskManager::set_snapshot_format(SnapshotFormat format) {
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        if (format == snapshot_format) {
             return;
         }
+        snapshot_format = format;
+    }
+    save();  // Rewrite the data file in the new format
+}
 
-        json j;
-        file >> j;  // Parse JSON from file
+// Get the snapshot format used for the data file
+SnapshotFormat TaskManager::get_snapshot_format() const {
+    return snapshot_format;
+}
 
-        // Validate JSON structure
-        if (!j.is_object()) {
-            std::cerr << "Warning: Invalid JSON structure, creating new file" << std::endl;
-            std::ofstream new_file(filename);
-            new_file << "{}";  // Reset to valid JSON
-            return;
+// Set JSON snapshot layout (takes effect with the next snapshot write)
+void TaskManager::set_json_style(JsonStyle style) {
+    std::lock_guard<std::mutex> lock(tasks_mutex);
+    json_style = style;
+}
+
+// Get JSON snapshot layout
+JsonStyle TaskManager::get_json_style() const {
+    return json_style;
+}
+
+// Export all tasks to a human-editable JSON file
+bool TaskManager::export_json(const std::string& path) const {
+    PROFILE_SCOPE("TaskManager::export_json");
+    return write_json_snapshot(path, tasks.dense_values());
+}
+
+// Import tasks from a JSON file, replacing tasks with the same id
+bool TaskManager::import_json(const std::string& path) {
+    PROFILE_SCOPE("TaskManager::import_json");
+    std::vector<Task> imported;
+    if (read_json_snapshot(path, imported) != SnapshotStatus::Ok) {
+        std::cerr << "Error: Cannot import tasks from " << path << std::endl;
+        return false;
+    }
+
+    begin_batch();  // Persist the whole import at once
+    for (Task& task : imported) {
+        JournalRecord record;
+        record.op = JournalRecord::Op::Add;
+        record.id = task.id;
+        record.title = task.title;
+        record.done = task.done;
+
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        upsert_task(std::move(task));
+        persist(record);
+    }
+    commit_batch();
+    return true;
+}
+
+// Set the debounce window of the save worker
+void TaskManager::set_save_debounce(std::chrono::milliseconds delay) {
+    std::lock_guard<std::mutex> lock(worker_mutex);
+    save_debounce = delay;
+}
+
+// Get a copy of the persistence metrics
+PersistenceStats TaskManager::get_persistence_stats() const {
+    std::lock_guard<std::mutex> lock(worker_mutex);
+    return stats;
+}
+
+// Set the UUID version for new tasks
+void TaskManager::set_uuid_version(UuidVersion version) {
+    uuid_version = version;
+}
+
+// Get the UUID version for new tasks
+UuidVersion TaskManager::get_uuid_version() const {
+    return uuid_version;
+}
+
+// Background worker: coalesces snapshot requests and writes them off the UI thread
+void TaskManager::save_worker_loop() {
+    TraceRecorder::instance().set_thread_name("Save worker");
+
+    std::unique_lock<std::mutex> lock(worker_mutex);
+    while (true) {
+        worker_cv.wait(lock, [this] { return snapshot_requested || stop_worker; });
+        if (stop_worker) {
+            break;  // Destructor performs the final save
         }
 
-        // Process each task in the JSON
-        for (const auto& [id, task_data] : j.items()) {
-            try {
-                // Validate required fields exist
-                if (task_data.contains("title") && task_data.contains("done")) {
-                    tasks[id] = Task(id, task_data["title"], task_data["done"]);
-                } else {
-                    std::cerr << "Warning: Skipping task " << id << " - missing required fields" << std::endl;
-                }
-            } catch (const json::exception& e) {
-                std::cerr << "Warning: Skipping task " << id << " - invalid data: " << e.what() << std::endl;
-            }
+        // Let the burst of changes settle; everything arriving meanwhile shares this write
+        worker_cv.wait_for(lock, save_debounce, [this] { return stop_worker; });
+        if (stop_worker) {
+            break;
         }
+        snapshot_requested = false;
+
+        lock.unlock();
+        bool written = write_snapshot();
+        lock.lock();
 
-    } catch (const json::parse_error& e) {
-        // Handle JSON parsing errors
-        std::cerr << "Error: JSON parse error in " << filename << ": " << e.what() << std::endl;
-        std::cerr << "Creating new data file..." << std::endl;
-        
-        std::ofstream file(filename);
-        file << "{}";  // Reset file with valid JSON
-        tasks.clear();  // Clear any partially loaded tasks
-    } catch (const std::exception& e) {
-        std::cerr << "Error loading data from " << filename << ": " << e.what() << std::endl;
+        if (!written) {
+            snapshot_requested = true;  // Retry after the next debounce window
+        }
     }
 }
 
-// Save tasks to JSON file
+// Save tasks to JSON file synchronously
 void TaskManager::save() {
-    try {
-        json j = json::object();  // Create root JSON object
-        
-        // Convert each task to JSON format
-        for (const auto& [id, task] : tasks) {
-            j[id] = {
-                {"title", task.title},
-                {"done", task.done}
-            };
+    write_snapshot();
+}
+
+// Write a snapshot of the tasks to the data file
+// The tasks are copied one chunk of slots per hold of tasks_mutex and
+// serialized without holding it, so mutations wait for one chunk at most.
+// Mutations during the copy keep the old tasks (preserve_for_snapshot()), so
+// the snapshot is the state at the start of the copy and matches
+// journal_offset. The snapshot goes to a temporary file that is renamed over
+// the old one, and only then are the journal records it covers dropped.
+bool TaskManager::write_snapshot() {
+    PROFILE_SCOPE("TaskManager::write_snapshot");
+    std::lock_guard<std::mutex> write_lock(snapshot_mutex);
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<Task> snapshot;
+    std::uintmax_t journal_offset = 0;
+    size_t covered_mutations = 0;
+    size_t task_count = 0;
+    SnapshotFormat format = SnapshotFormat::Json;
+    JsonStyle style = JsonStyle::Pretty;
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        format = snapshot_format;
+        style = json_style;
+        journal_offset = journal.size_bytes();  // Records past this offset are not in the snapshot
+        task_count = tasks.size();
+
+        snapshot_copying = true;
+        snapshot_aborted = false;
+        snapshot_cursor = 0;
+        snapshot_slot_end = static_cast<uint32_t>(tasks.slot_capacity());
+        snapshot_touched.clear();
+        snapshot_preimages.clear();
+
+        std::lock_guard<std::mutex> worker_lock(worker_mutex);
+        covered_mutations = stats.queue_depth;
+        stats.queue_depth = 0;
+    }
+
+    snapshot.reserve(task_count);
+    bool copied = false;
+    while (true) {
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        if (snapshot_aborted) {
+            snapshot_copying = false;
+            break;
         }
-        
-        std::ofstream file(filename);
-        if (!file.is_open()) {
-            std::cerr << "Error: Cannot save to file " << filename << std::endl;
-            return;
+
+        uint32_t end = snapshot_slot_end - snapshot_cursor > snapshot_chunk_slots ? snapshot_cursor + snapshot_chunk_slots
+                                                                                  : snapshot_slot_end;
+        for (uint32_t slot = snapshot_cursor; slot < end; slot++) {
+            if (tasks.slot_occupied(slot) && !snapshot_touched.test(slot)) {
+                snapshot.push_back(tasks.at_slot(slot));  // Unchanged since the start
+            }
         }
-        
-        file << j.dump(4);  // Write JSON with 4-space indentation
-        
-    } catch (const std::exception& e) {
-        std::cerr << "Error saving data to " << filename << ": " << e.what() << std::endl;
-    }
-}
-
-// Generate UUID for new tasks
-std::string TaskManager::generate_uuid() const {
-    // Fallback if COM is not initialized
-    if (!com_initialized) {
-        std::cerr << "Error: COM not initialized, using fallback UUID" << std::endl;
-        return "fallback-uuid-" + std::to_string(rand());
-    }
-    
-    GUID guid;
-    HRESULT hr = CoCreateGuid(&guid);  // Generate GUID using Windows API
-    
-    if (FAILED(hr)) {
-        std::cerr << "Error: Failed to create GUID" << std::endl;
-        return "error-uuid-" + std::to_string(rand());
-    }
-    
-    // Format GUID as string (8-4-4-4-12 format)
-    char buffer[37];
-    snprintf(buffer, sizeof(buffer),
-             "%08lX-%04X-%04X-%02X%02X-%02X%02X%02X%02X%02X%02X",
-             guid.Data1, guid.Data2, guid.Data3,
-             guid.Data4[0], guid.Data4[1], guid.Data4[2], guid.Data4[3],
-             guid.Data4[4], guid.Data4[5], guid.Data4[6], guid.Data4[7]);
-    
-    return std::string(buffer);
+        snapshot_cursor = end;
+
+        if (end == snapshot_slot_end) {
+            // Tasks changed or erased during the copy, as they were at the start
+            std::move(snapshot_preimages.begin(), snapshot_preimages.end(), std::back_inserter(snapshot));
+            snapshot_preimages.clear();
+            snapshot_copying = false;
+            copied = true;
+            break;
+        }
+    }
+
+    if (!copied) {
+        std::cerr << "Warning: Tasks were reloaded during the snapshot copy, writing it later" << std::endl;
+        note_mutation(covered_mutations, false);  // Still not in any snapshot
+        return false;
+    }
+
+    std::string temp_filename = filename + ".tmp";
+    if (!write_snapshot_file(temp_filename, snapshot, format, style)) {
+        note_mutation(covered_mutations, false);  // Still pending: count them in the queue again
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temp_filename, filename, ec);  // Replace old snapshot
+    if (ec) {
+        std::cerr << "Error saving data to " << filename << ": " << ec.message() << std::endl;
+        note_mutation(covered_mutations, false);
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(tasks_mutex);
+        journal.discard_prefix(journal_offset);  // Snapshot now contains these records
+    }
+
+    double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> worker_lock(worker_mutex);
+    stats.snapshots_written++;
+    stats.mutations_coalesced += covered_mutations;
+    stats.last_write_ms = elapsed_ms;
+    stats.total_write_ms += elapsed_ms;
+    if (elapsed_ms > stats.max_write_ms) {
+        stats.max_write_ms = elapsed_ms;
+    }
+    return true;
 }
 
 // Add a new task with the given title
 void TaskManager::add_task(const std::string& title) {
-    std::string task_id = generate_uuid();  // Generate unique ID
-    tasks[task_id] = Task(task_id, title, false);  // Create new task (not done)
-    save();  // Persist changes to file
+    PROFILE_SCOPE("TaskManager::add_task");
+    TaskId task_id = generate_uuid(uuid_version);  // Generate unique ID (no locks, no OS calls)
+
+    std::lock_guard<std::mutex> lock(tasks_mutex);
+    upsert_task(Task(task_id, title, false));  // Create new task (not done)
+
+    JournalRecord record;
+    record.op = JournalRecord::Op::Add;
+    record.id = task_id;
+    record.title = title;
+    persist(record);  // Persist changes to file
 }
 
 // Delete a task by ID
-void TaskManager::delete_task(const std::string& task_id) {
-    tasks.erase(task_id);  // Remove task from map
-    save();  // Persist changes to file
+void TaskManager::delete_task(const TaskId& task_id) {
+    PROFILE_SCOPE("TaskManager::delete_task");
+    std::lock_guard<std::mutex> lock(tasks_mutex);
+    if (!erase_task(task_id)) {  // Remove task from map
+        return;  // Nothing to persist
+    }
+
+    JournalRecord record;
+    record.op = JournalRecord::Op::Delete;
+    record.id = task_id;
+    persist(record);  // Persist changes to file
 }
 
 // Toggle task completion status
-void TaskManager::toggle_task_status(const std::string& task_id) {
-    auto it = tasks.find(task_id);
-    if (it != tasks.end()) {
-        Task& task = it->second;
-        task.done = !task.done;  // Flip completion status
-        save();  // Persist changes to file
+void TaskManager::toggle_task_status(const TaskId& task_id) {
+    PROFILE_SCOPE("TaskManager::toggle_task_status");
+    std::lock_guard<std::mutex> lock(tasks_mutex);
+    auto it = id_index.find(task_id);
+    if (it != id_index.end()) {
+        uint32_t slot = it->second.index;
+        set_task_done(slot, !tasks.at_slot(slot).done);  // Flip completion status and move partitions
+
+        JournalRecord record;
+        record.op = JournalRecord::Op::SetDone;
+        record.id = task_id;
+        record.done = tasks.at_slot(slot).done;
+        persist(record);  // Persist changes to file
     }
 }
 
 // Check if task exists by ID
-bool TaskManager::contains_task(const std::string& task_id) const {
-    return tasks.find(task_id) != tasks.end();
+bool TaskManager::contains_task(const TaskId& task_id) const {
+    return id_index.find(task_id) != id_index.end();
 }
 
 // Check if there are no tasks
@@ -180,22 +581,195 @@ bool TaskManager::is_empty() const {
     return tasks.empty();
 }
 
+// Get change counter of the task set
+uint64_t TaskManager::get_generation() const {
+    return generation;
+}
+
+// Get total number of tasks
+size_t TaskManager::task_count() const {
+    return tasks.size();
+}
+
+// Get number of uncompleted tasks
+size_t TaskManager::uncompleted_count() const {
+    return uncompleted_index.size();
+}
+
+// Get number of completed tasks
+size_t TaskManager::completed_count() const {
+    return completed_index.size();
+}
+
+// View constructor over the packed task array
+TaskManager::TaskView::TaskView(const SlotMap<Task>& tasks)
+    : store(&tasks), count(tasks.size()) {}
+
+// View constructor over a run of slot indices
+TaskManager::TaskView::TaskView(const SlotMap<Task>& tasks, const uint32_t* slot_list, size_t slot_count)
+    : store(&tasks), slots(slot_list), count(slot_count) {}
+
+// View every task in storage order
+TaskManager::TaskView TaskManager::all_tasks_view() const {
+    return TaskView(tasks);
+}
+
+// View uncompleted tasks
+TaskManager::TaskView TaskManager::uncompleted_view() const {
+    uncompleted_index.normalize();
+    return TaskView(tasks, uncompleted_index.slots().data(), uncompleted_index.size());
+}
+
+// View completed tasks
+TaskManager::TaskView TaskManager::completed_view() const {
+    completed_index.normalize();
+    return TaskView(tasks, completed_index.slots().data(), completed_index.size());
+}
+
+// View every task in id order
+TaskManager::TaskView TaskManager::ordered_view() const {
+    ordered_index.normalize();
+    return TaskView(tasks, ordered_index.slots().data(), ordered_index.size());
+}
+
+// View a range of ids
+TaskManager::TaskView TaskManager::id_range_view(const TaskId& first, const TaskId& last) const {
+    ordered_index.normalize();
+    size_t begin = ordered_index.lower_bound(first);
+    size_t end = std::max(begin, ordered_index.lower_bound(last));
+    return TaskView(tasks, ordered_index.slots().data() + begin, end - begin);
+}
+
+// View tasks created since a point in time
+TaskManager::TaskView TaskManager::created_since_view(uint64_t unix_ms) const {
+    ordered_index.normalize();
+    size_t begin = ordered_index.lower_bound(uuid_v7_lower_bound(unix_ms));
+    return TaskView(tasks, ordered_index.slots().data() + begin, ordered_index.size() - begin);
+}
+
+// Search titles through the trigram index
+void TaskManager::search_titles(const std::string& query, TitleSearchResult& result) const {
+    PROFILE_SCOPE("TaskManager::search_titles");
+    result.uncompleted_slots.clear();
+    result.completed_slots.clear();
+
+    const std::string folded = fold_ascii_case(query);
+    TaskView uncompleted = uncompleted_view();
+    TaskView completed = completed_view();
+
+    std::vector<uint32_t>& candidates = result.candidates;
+    if (title_index.find_candidates(folded, candidates)) {
+        // Candidates have every trigram, but not necessarily next to each other.
+        // When most titles are candidates, one scan of the column checks them
+        // faster than reading each candidate's title.
+        const bool verify = folded.size() > 3 || !TrigramIndex::is_exact(folded);
+        if (verify && candidates.size() * 8 > tasks.size() && folded.find('\0') == std::string::npos) {
+            candidates.clear();
+            title_column.find(folded, candidates);
+        } else if (verify) {
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                            [&](uint32_t slot) { return !contains_folded(tasks.at_slot(slot).title, folded); }),
+                             candidates.end());
+        }
+    } else if (!title_column.find(folded, candidates)) {
+        // Too short for trigrams and not scannable in the column ('\0' in the query): check every title
+        for (size_t i = 0; i < tasks.size(); i++) {
+            if (contains_folded(tasks.dense_values()[i].title, folded)) {
+                candidates.push_back(tasks.slot_at(i));
+            }
+        }
+    }
+
+    // Few matches: sort them by id. Many: walk the partitions (already in
+    // id order) and keep the matching slots, which avoids the random reads
+    // of a comparison sort.
+    if (candidates.size() * 64 < tasks.size()) {
+        for (uint32_t slot : candidates) {
+            (completed_slots.test(slot) ? result.completed_slots : result.uncompleted_slots).push_back(slot);
+        }
+        auto by_id = [this](uint32_t a, uint32_t b) { return tasks.at_slot(a).id < tasks.at_slot(b).id; };
+        std::sort(result.uncompleted_slots.begin(), result.uncompleted_slots.end(), by_id);
+        std::sort(result.completed_slots.begin(), result.completed_slots.end(), by_id);
+    } else {
+        result.matches.clear();
+        for (uint32_t slot : candidates) {
+            result.matches.set(slot);
+        }
+        for (size_t i = 0; i < uncompleted.size(); i++) {
+            if (result.matches.test(uncompleted.slots[i])) {
+                result.uncompleted_slots.push_back(uncompleted.slots[i]);
+            }
+        }
+        for (size_t i = 0; i < completed.size(); i++) {
+            if (result.matches.test(completed.slots[i])) {
+                result.completed_slots.push_back(completed.slots[i]);
+            }
+        }
+    }
+}
+
+// View the matches of a search
+TaskManager::TaskView TaskManager::search_view(const TitleSearchResult& result, bool done) const {
+    const std::vector<uint32_t>& slots = done ? result.completed_slots : result.uncompleted_slots;
+    return TaskView(tasks, slots.data(), slots.size());
+}
+
+// Scan every title for a substring
+void TaskManager::scan_titles(std::string_view query, std::vector<TaskHandle>& out) const {
+    PROFILE_SCOPE("TaskManager::scan_titles");
+    out.clear();
+    const std::string folded = fold_ascii_case(std::string(query));
+    std::vector<uint32_t> slots;
+    if (title_column.find(folded, slots)) {
+        out.reserve(slots.size());
+        for (uint32_t slot : slots) {
+            out.push_back(tasks.handle_of_slot(slot));
+        }
+        return;
+    }
+
+    // The query contains '\0', which the column uses as a separator: check each title
+    for (size_t i = 0; i < tasks.size(); i++) {
+        if (contains_folded(tasks.dense_values()[i].title, folded)) {
+            out.push_back(tasks.handle_at(i));
+        }
+    }
+}
+
+// Get the memory used by the title index and the title column
+size_t TaskManager::get_search_index_bytes() const {
+    return title_index.get_memory_bytes() + title_column.get_memory_bytes();
+}
+
+// Look up a task without copying it
+const Task* TaskManager::find_task(const TaskId& task_id) const {
+    auto it = id_index.find(task_id);
+    return it != id_index.end() ? tasks.get(it->second) : nullptr;
+}
+
+// Look up the handle of a task
+TaskHandle TaskManager::find_handle(const TaskId& task_id) const {
+    auto it = id_index.find(task_id);
+    return it != id_index.end() ? it->second : TaskHandle{};
+}
+
+// Resolve a handle to its task
+const Task* TaskManager::get_task(TaskHandle handle) const {
+    return tasks.get(handle);
+}
+
 // Get all tasks as a vector
 std::vector<Task> TaskManager::get_all_tasks() const {
-    std::vector<Task> result;
-    for (const auto& [id, task] : tasks) {
-        result.push_back(task);  // Copy each task to vector
-    }
-    return result;
+    return tasks.dense_values();  // Tasks are already packed, copy them in one go
 }
 
 // Get only uncompleted tasks
 std::vector<Task> TaskManager::get_uncompleted_tasks() const {
     std::vector<Task> result;
-    for (const auto& [id, task] : tasks) {
-        if (!task.done) {
-            result.push_back(task);  // Add only incomplete tasks
-        }
+    uncompleted_index.normalize();
+    result.reserve(uncompleted_index.size());
+    for (uint32_t slot : uncompleted_index.slots()) {
+        result.push_back(tasks.at_slot(slot));  // Partition holds only incomplete tasks
     }
     return result;
 }
@@ -203,68 +777,130 @@ std::vector<Task> TaskManager::get_uncompleted_tasks() const {
 // Get only completed tasks
 std::vector<Task> TaskManager::get_completed_tasks() const {
     std::vector<Task> result;
-    for (const auto& [id, task] : tasks) {
-        if (task.done) {
-            result.push_back(task);  // Add only completed tasks
-        }
+    completed_index.normalize();
+    result.reserve(completed_index.size());
+    for (uint32_t slot : completed_index.slots()) {
+        result.push_back(tasks.at_slot(slot));  // Partition holds only completed tasks
     }
     return result;
 }
 
 // Get task information by ID
-Task TaskManager::get_task_info(const std::string& task_id) const {
-    auto it = tasks.find(task_id);
-    if (it != tasks.end()) {
-        return it->second;  // Return found task
+Task TaskManager::get_task_info(const TaskId& task_id) const {
+    if (const Task* task = find_task(task_id)) {
+        return *task;  // Return found task
     }
-    return Task("", "");  // Return empty task if not found
+    return Task();  // Return empty task (nil id) if not found
 }
 
-// Initialize selection states for all tasks (used in UI modals)
+// Start a fresh selection (used in UI modals)
 void TaskManager::init_selection_states() {
-    task_selection_states.clear();
-    for (const auto& [id, task] : tasks) {
-        task_selection_states[id] = false;  // Initialize all as unselected
-    }
+    selected_slots.clear();  // O(slots / 64), no per-task work
 }
 
 // Toggle selection state for a specific task
-void TaskManager::toggle_task_selection(const std::string& task_id) {
-    if (task_selection_states.find(task_id) != task_selection_states.end()) {
-        task_selection_states[task_id] = !task_selection_states[task_id];  // Flip selection state
-    } else {
-        task_selection_states[task_id] = true;  // Select if not in map
+void TaskManager::toggle_task_selection(const TaskId& task_id) {
+    auto it = id_index.find(task_id);
+    if (it != id_index.end()) {
+        selected_slots.flip(it->second.index);  // Flip selection state
+    }
+}
+
+// Toggle selection state of the task behind a handle
+void TaskManager::toggle_task_selection(TaskHandle handle) {
+    if (tasks.contains(handle)) {
+        selected_slots.flip(handle.index);
     }
 }
 
 // Check if a task is currently selected
-bool TaskManager::is_task_selected(const std::string& task_id) const {
-    auto it = task_selection_states.find(task_id);
-    return it != task_selection_states.end() ? it->second : false;  // Return false if not found
+bool TaskManager::is_task_selected(const TaskId& task_id) const {
+    auto it = id_index.find(task_id);
+    return it != id_index.end() && selected_slots.test(it->second.index);  // False if not found
+}
+
+// Check if the task behind a handle is selected
+bool TaskManager::is_task_selected(TaskHandle handle) const {
+    return tasks.contains(handle) && selected_slots.test(handle.index);
 }
 
 // Clear all task selections
 void TaskManager::clear_selection() {
-    for (auto& [id, selected] : task_selection_states) {
-        selected = false;  // Deselect all tasks
+    selected_slots.clear();
+}
+
+// Select every live task
+void TaskManager::select_all() {
+    selected_slots.copy_from(live_slots);
+}
+
+// Invert the selection within the live tasks
+void TaskManager::invert_selection() {
+    selected_slots.flip_masked(live_slots);
+}
+
+// Add all tasks with a status to the selection
+void TaskManager::select_by_status(bool done) {
+    if (done) {
+        selected_slots.merge(completed_slots);
+    } else {
+        selected_slots.merge_difference(live_slots, completed_slots);
     }
 }
 
-// Get IDs of all selected tasks
-std::vector<std::string> TaskManager::get_selected_task_ids() const {
-    std::vector<std::string> selected;
-    for (const auto& [id, selected_state] : task_selection_states) {
-        if (selected_state) {
-            selected.push_back(id);  // Add ID if task is selected
+// Remove all tasks with a status from the selection
+void TaskManager::deselect_by_status(bool done) {
+    if (done) {
+        selected_slots.subtract(completed_slots);
+    } else {
+        selected_slots.intersect(completed_slots);  // Selected tasks are live, so this keeps the completed ones
+    }
+}
+
+// Set the selection of a run of view positions
+void TaskManager::set_range_selected(const TaskView& view, size_t first, size_t last, bool selected) {
+    for (size_t i = first; i <= last && i < view.size(); i++) {
+        uint32_t slot = view.slots ? view.slots[i] : tasks.slot_at(i);
+        selected_slots.assign(slot, selected);
+    }
+}
+
+// Flip the selection of the tasks in a view
+void TaskManager::invert_view_selection(const TaskView& view) {
+    for (size_t i = 0; i < view.size(); i++) {
+        uint32_t slot = view.slots ? view.slots[i] : tasks.slot_at(i);
+        selected_slots.assign(slot, !selected_slots.test(slot));
+    }
+}
+
+// Keep only the selected tasks listed by two views
+void TaskManager::restrict_selection(const TaskView& first, const TaskView& second) {
+    SlotBitset listed;
+    for (const TaskView* view : {&first, &second}) {
+        for (size_t i = 0; i < view->size(); i++) {
+            listed.set(view->slots ? view->slots[i] : tasks.slot_at(i));
         }
     }
+    selected_slots.intersect(listed);
+}
+
+// Get IDs of all selected tasks
+std::vector<TaskId> TaskManager::get_selected_task_ids() const {
+    PROFILE_SCOPE("TaskManager::get_selected_task_ids");
+    std::vector<TaskId> selected;
+    selected.reserve(selected_slots.get_count());
+    selected_slots.for_each_set([&](uint32_t slot) {
+        selected.push_back(tasks.at_slot(slot).id);  // Add ID of each selected task
+    });
     return selected;
 }
 
 // Check if any tasks are currently selected
 bool TaskManager::has_selection() const {
-    for (const auto& [id, selected] : task_selection_states) {
-        if (selected) return true;  // Return true if any task is selected
-    }
-    return false;
+    return selected_slots.any();
+}
+
+// Get number of selected tasks
+size_t TaskManager::get_selection_count() const {
+    return selected_slots.get_count();
 }
\ No newline at end of file
@@ -2,99 +2,492 @@
 #define TASK_MANAGER_H
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <unordered_map>
+#include <cstdint>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <iterator>
+#include <cstddef>
 #include "task.h"
+#include "task_journal.h"
+#include "task_storage.h"
+#include "slot_map.h"
+#include "slot_bitset.h"
+#include "uuid_generator.h"
+#include "ordered_task_index.h"
+#include "trigram_index.h"
+#include "title_column.h"
 #include "json.hpp"
 
-// Windows API includes for UUID generation
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
-#include <objbase.h>
-
 using json = nlohmann::json;
 
+// Stable reference to a stored task (slot index + generation, 64 bits)
+// Stays valid across other mutations; resolves to nothing once the task is deleted.
+using TaskHandle = SlotHandle;
+
+// How mutations are persisted to disk
+enum class PersistenceMode {
+    Snapshot,   // Rewrite the whole data file after every mutation
+    Journal     // Append a record to the journal, compact into a snapshot when it grows
+};
+
+// Counters describing background persistence activity
+struct PersistenceStats {
+    size_t queue_depth = 0;           // Mutations not yet folded into a snapshot
+    size_t snapshots_written = 0;     // Snapshot writes completed (background and explicit)
+    size_t mutations_coalesced = 0;   // Mutations covered by those snapshot writes
+    double last_write_ms = 0.0;       // Duration of the most recent snapshot write
+    double max_write_ms = 0.0;        // Slowest snapshot write so far
+    double total_write_ms = 0.0;      // Sum of all write durations (for averages)
+};
+
+// Result of TaskManager::search_titles(), owned by the caller
+// Reusing one result for repeated searches keeps its buffers.
+struct TitleSearchResult {
+    std::vector<uint32_t> uncompleted_slots;    // Matching uncompleted tasks, in id order
+    std::vector<uint32_t> completed_slots;      // Matching completed tasks, in id order
+    std::vector<uint32_t> candidates;           // Matching slots of both statuses (index or column order)
+    SlotBitset matches;                         // Matches by slot (ordering large results)
+};
+
 // Main class for managing tasks with persistence and selection functionality
+// All public methods are called from the UI thread. Snapshot writes run on a
+// background worker that only reads the tasks while holding tasks_mutex.
 class TaskManager {
 private:
-    // Storage for tasks using UUID as key for efficient lookup
-    std::unordered_map<std::string, Task> tasks;
+    // Tasks packed contiguously; handles stay stable while tasks move inside the array
+    SlotMap<Task> tasks;
+
+    // Task ID -> handle
+    std::unordered_map<TaskId, TaskHandle> id_index;
+
+    // Partition indexes kept up to date on every add, delete and toggle, so
+    // status queries never scan all tasks. Both are ordered by task id (creation
+    // order for V7 ids) and normalized lazily when a view is requested, which is
+    // why they are mutable.
+    mutable OrderedTaskIndex uncompleted_index;
+    mutable OrderedTaskIndex completed_index;
+
+    // Every task ordered by id, for range queries
+    mutable OrderedTaskIndex ordered_index;
+
+    // Title trigrams -> slots, for substring search (posting lists are merged lazily by queries)
+    mutable TrigramIndex title_index;
+
+    // Every title in one buffer, for scans of queries too short for the index
+    TitleColumn title_column;
+
+    // Incremented on every change to the task set (lets the UI skip rebuilding unchanged lists)
+    uint64_t generation = 0;
     
-    // Track which tasks are selected in the UI (for bulk operations)
-    std::unordered_map<std::string, bool> task_selection_states;
+    // Occupied slots and slots of completed tasks, kept up to date with the
+    // partition indexes so bulk selection works on 64 tasks per step
+    SlotBitset live_slots;
+    SlotBitset completed_slots;
+
+    // Slots of the tasks selected in the UI (for bulk operations), always a subset of live_slots
+    SlotBitset selected_slots;
     
     // File path for JSON data persistence
     std::string filename;
-    
-    // Flag indicating if COM is initialized for UUID generation
-    bool com_initialized = false;
-    
-    // Generate unique identifier for new tasks
-    std::string generate_uuid() const;
+
+    // Active persistence strategy for mutations
+    PersistenceMode persistence_mode;
+
+    // Encoding used when writing the snapshot file
+    SnapshotFormat snapshot_format;
+
+    // Layout of JSON snapshots (pretty for hand editing, compact for size and speed)
+    JsonStyle json_style = JsonStyle::Pretty;
+
+    // Write-ahead journal of mutations not yet folded into the snapshot
+    TaskJournal journal;
+
+    // Journal size (bytes) after which it is compacted into a new snapshot
+    std::uintmax_t compaction_threshold = 4 * 1024 * 1024;
+
+    // Nesting depth of begin_batch()/commit_batch() pairs (0 = no batch open)
+    int batch_depth = 0;
+
+    // Records collected while a batch is open, persisted on commit
+    std::vector<JournalRecord> pending_records;
+
+    // Background persistence
+
+    // Guards tasks and journal against the worker taking a snapshot
+    // (mutations lock it; UI-thread reads do not need to)
+    mutable std::mutex tasks_mutex;
+
+    // Serializes snapshot writes (worker and explicit save())
+    std::mutex snapshot_mutex;
+
+    // Guards the worker state and persistence statistics below
+    mutable std::mutex worker_mutex;
+
+    // Wakes the worker when a snapshot is requested or on shutdown
+    std::condition_variable worker_cv;
+
+    // Thread writing snapshots off the UI thread
+    std::thread save_worker;
+
+    // Set when the state changed and a snapshot write is due
+    bool snapshot_requested = false;
+
+    // Set by the destructor to stop the worker
+    bool stop_worker = false;
+
+    // Delay between the first change and the write, so bursts coalesce into one write
+    std::chrono::milliseconds save_debounce{250};
+
+    // Background persistence metrics
+    PersistenceStats stats;
+
+    // Copy-on-write state of the snapshot being copied by write_snapshot()
+    // The copy walks the slots a chunk at a time and releases tasks_mutex in
+    // between. A mutation of a slot the copy has not reached yet first keeps
+    // the task as it was, so the snapshot still shows the state at its start.
+    // All of it is guarded by tasks_mutex.
+    static constexpr uint32_t snapshot_chunk_slots = 16384;   // Slots copied per lock hold
+    bool snapshot_copying = false;              // A snapshot copy is in progress
+    bool snapshot_aborted = false;              // load() replaced the tasks during the copy
+    uint32_t snapshot_cursor = 0;               // Slots below this one are already copied
+    uint32_t snapshot_slot_end = 0;             // Slot capacity when the copy started
+    SlotBitset snapshot_touched;                // Uncopied slots changed since the start (the copy skips them)
+    std::vector<Task> snapshot_preimages;       // Tasks of those slots as they were at the start
+
+    // Layout of ids minted for new tasks (V7 keeps lists in creation order)
+    UuidVersion uuid_version = UuidVersion::V7;
+
+    // Read the snapshot file into task storage
+    void load_snapshot();
+
+    // Replay journal records on top of the loaded snapshot
+    void replay_journal();
+
+    // Apply a single journal record to the in-memory tasks (moves the title out of Add records)
+    void apply_record(JournalRecord& record);
+
+    // Partition index holding tasks with the given status
+    OrderedTaskIndex& partition_for(bool done);
+
+    // Insert or replace a task and index it in its partition
+    void upsert_task(Task task);
+
+    // Remove a task and its partition entry; returns false if it does not exist
+    bool erase_task(const TaskId& task_id);
+
+    // Change the status of the task in a slot, moving it between partitions
+    void set_task_done(uint32_t slot, bool done);
+
+    // Keep the task in `slot` for the snapshot being copied, if the copy has not reached it
+    // Called before a task is changed or erased, and after a task is inserted
+    // (`inserted`: the slot was free when the copy started, so it is only skipped).
+    void preserve_for_snapshot(uint32_t slot, bool inserted);
+
+    // Append a slot to the partition of its task
+    void partition_add(uint32_t slot);
+
+    // Remove a slot from the partition of its task
+    void partition_remove(uint32_t slot);
+
+    // Persist one mutation according to the active persistence mode
+    void persist(const JournalRecord& record);
+
+    // Persist all records collected by the current batch at once
+    void flush_pending();
+
+    // Count a persisted mutation and optionally wake the worker for a snapshot
+    void note_mutation(size_t count, bool need_snapshot);
+
+    // Copy the tasks (in chunks, see snapshot_copying), write them to the snapshot file and trim the journal
+    // Returns false if the snapshot could not be written
+    bool write_snapshot();
+
+    // Worker thread body: waits for requests, debounces and writes snapshots
+    void save_worker_loop();
 
 public:
-    // Constructor: Initializes task manager with data file path
-    TaskManager(const std::string& data_file = "data.json");
+    // Read-only, zero-copy range of tasks
+    //
+    // Views reference the TaskManager's own storage: iterating or indexing
+    // never copies a Task or allocates. A view, and every Task reference
+    // obtained from it, is invalidated by any call that changes the task set
+    // (add_task, delete_task, toggle_task_status, commit_batch, load,
+    // import_json). Selection changes and saves do not invalidate views.
+    // Partition, ordered and range views list tasks in id order, which is
+    // creation order for V7 ids; all_tasks_view() uses storage order.
+    // Use handle_at() to keep a reference that survives mutations.
+    class TaskView {
+    private:
+        friend class TaskManager;
+
+        const SlotMap<Task>* store = nullptr;   // Task storage
+        const uint32_t* slots = nullptr;        // Slot indices (nullptr = packed order)
+        size_t count = 0;
+
+        TaskView(const SlotMap<Task>& tasks);
+        TaskView(const SlotMap<Task>& tasks, const uint32_t* slot_list, size_t slot_count);
+
+    public:
+        // Forward iterator yielding const Task references
+        class iterator {
+        private:
+            const TaskView* view = nullptr;
+            size_t index = 0;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Task;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Task*;
+            using reference = const Task&;
+
+            iterator() = default;
+            iterator(const TaskView* owner, size_t position) : view(owner), index(position) {}
+
+            reference operator*() const { return (*view)[index]; }
+            pointer operator->() const { return &(*view)[index]; }
+            iterator& operator++() { index++; return *this; }
+            iterator operator++(int) { iterator copy = *this; index++; return copy; }
+            bool operator==(const iterator& other) const { return index == other.index; }
+            bool operator!=(const iterator& other) const { return index != other.index; }
+        };
+
+        // Empty view
+        TaskView() = default;
+
+        // Number of tasks in the view
+        size_t size() const { return count; }
+
+        // Check if the view has no tasks
+        bool empty() const { return size() == 0; }
+
+        // Access a task by position (0 <= index < size())
+        const Task& operator[](size_t index) const {
+            return slots ? store->at_slot(slots[index]) : store->dense_values()[index];
+        }
+
+        // Handle of the task at a position
+        TaskHandle handle_at(size_t index) const {
+            return slots ? store->handle_of_slot(slots[index]) : store->handle_at(index);
+        }
+
+        iterator begin() const { return iterator(this, 0); }
+        iterator end() const { return iterator(this, size()); }
+    };
+
+    // Constructor: Initializes task manager with data file path and persistence mode
+    TaskManager(const std::string& data_file = "data.json", PersistenceMode mode = PersistenceMode::Journal);
     
-    // Destructor: Saves data and cleans up resources
+    // Destructor: Stops the save worker and saves data
     ~TaskManager();
 
-    // Save all tasks to JSON file
+    // Save all tasks to the data file synchronously (also compacts the journal)
     void save();
     
-    // Load tasks from JSON file
+    // Load tasks from the data file and replay the journal
     void load();
 
+    // Persistence configuration
+
+    // Switch persistence mode (leaving journal mode folds the journal into the snapshot)
+    void set_persistence_mode(PersistenceMode mode);
+
+    // Get active persistence mode
+    PersistenceMode get_persistence_mode() const;
+
+    // Set journal size in bytes that triggers compaction
+    void set_compaction_threshold(std::uintmax_t bytes);
+
+    // Set the snapshot encoding (default is chosen by file extension: ".bin" = binary)
+    // The data file is rewritten in the new format right away
+    void set_snapshot_format(SnapshotFormat format);
+
+    // Get the snapshot encoding of the data file
+    SnapshotFormat get_snapshot_format() const;
+
+    // Set the layout used when the snapshot is written as JSON
+    void set_json_style(JsonStyle style);
+
+    // Get the layout used for JSON snapshots
+    JsonStyle get_json_style() const;
+
+    // Export all tasks as a human-editable JSON file
+    bool export_json(const std::string& path) const;
+
+    // Import tasks from a JSON file (tasks with the same id are replaced)
+    bool import_json(const std::string& path);
+
+    // Set how long the worker waits after a change before writing a snapshot
+    void set_save_debounce(std::chrono::milliseconds delay);
+
+    // Get a copy of the background persistence metrics
+    PersistenceStats get_persistence_stats() const;
+
+    // Set the UUID version used for new task ids (existing ids are kept)
+    void set_uuid_version(UuidVersion version);
+
+    // Get the UUID version used for new task ids
+    UuidVersion get_uuid_version() const;
+
     // Core task operations
     
     // Add a new task with given title (automatically generates UUID)
     void add_task(const std::string& title);
     
     // Delete task by its unique identifier
-    void delete_task(const std::string& task_id);
+    void delete_task(const TaskId& task_id);
     
     // Toggle completion status of a task (complete/incomplete)
-    void toggle_task_status(const std::string& task_id);
+    void toggle_task_status(const TaskId& task_id);
+
+    // Batched mutations
+
+    // Start a batch: mutations are applied in memory but not persisted until commit
+    // Batches may be nested; only the outermost commit persists
+    void begin_batch();
+
+    // Finish a batch and persist all of its mutations with a single write
+    void commit_batch();
+
+    // Check if a batch is currently open
+    bool in_batch() const;
 
     // Task query methods
     
     // Check if a task exists with the given ID
-    bool contains_task(const std::string& task_id) const;
+    bool contains_task(const TaskId& task_id) const;
     
     // Check if there are no tasks in the manager
     bool is_empty() const;
+
+    // Monotonically increasing counter, bumped by every change to the task set
+    // Equal generations guarantee that views and task contents are unchanged
+    uint64_t get_generation() const;
+
+    // Number of tasks in total, pending and completed (O(1))
+    size_t task_count() const;
+    size_t uncompleted_count() const;
+    size_t completed_count() const;
     
+    // Zero-copy views (see TaskView for invalidation rules)
+
+    // View of every task in storage order (walks the packed array, fastest full scan)
+    TaskView all_tasks_view() const;
+
+    // View of uncompleted (active) tasks in id order
+    // O(1), or O(n) once after mutations to merge the index
+    TaskView uncompleted_view() const;
+
+    // View of completed tasks in id order (same cost as uncompleted_view)
+    TaskView completed_view() const;
+
+    // View of every task in id order (same cost as uncompleted_view)
+    TaskView ordered_view() const;
+
+    // View of tasks with first <= id < last, O(log n) on top of ordered_view()
+    TaskView id_range_view(const TaskId& first, const TaskId& last) const;
+
+    // View of tasks created at or after `unix_ms` (V7 ids; V4 ids carry no time)
+    TaskView created_since_view(uint64_t unix_ms) const;
+
+    // Title search (ASCII case-insensitive substring match, any UTF-8 text)
+
+    // Find the tasks whose title contains `query`, split by status in id order
+    // Queries of 3+ bytes intersect trigram posting lists and check only the
+    // candidates (or scan the title column when most titles are candidates);
+    // shorter ones scan the title column.
+    void search_titles(const std::string& query, TitleSearchResult& result) const;
+
+    // View of the matches with the given status (valid until the task set or `result` changes)
+    TaskView search_view(const TitleSearchResult& result, bool done) const;
+
+    // Handles of every task whose title contains `query` (ASCII case-insensitive), in no particular order
+    // One vector scan over the title column (every title in one buffer), with
+    // no index lookups: O(total title bytes) whatever the query.
+    void scan_titles(std::string_view query, std::vector<TaskHandle>& out) const;
+
+    // Bytes used by the title search index and the title column
+    size_t get_search_index_bytes() const;
+
+    // Find a task by ID without copying it (nullptr if not found)
+    const Task* find_task(const TaskId& task_id) const;
+
+    // Handles
+
+    // Get the handle of a task by ID (null handle if not found)
+    TaskHandle find_handle(const TaskId& task_id) const;
+
+    // Resolve a handle (nullptr if the task was deleted since the handle was taken)
+    const Task* get_task(TaskHandle handle) const;
+
+    // Copying queries (each returned Task is an independent copy)
+
     // Get all tasks as a vector (for iteration)
     std::vector<Task> get_all_tasks() const;
     
-    // Get only uncompleted (active) tasks
+    // Get only uncompleted (active) tasks (O(result), served from the partition index)
     std::vector<Task> get_uncompleted_tasks() const;
     
-    // Get only completed tasks
+    // Get only completed tasks (O(result), served from the partition index)
     std::vector<Task> get_completed_tasks() const;
     
     // Get specific task information by ID
-    Task get_task_info(const std::string& task_id) const;
+    Task get_task_info(const TaskId& task_id) const;
 
     // Task selection methods (for UI bulk operations)
+    // Selection is a bitset over task slots: single-task calls are O(1),
+    // whole-list calls are O(slots / 64). Deleting a task deselects it.
     
-    // Initialize selection states for all tasks (call before showing selection modal)
+    // Start with nothing selected (call before showing selection modal)
     void init_selection_states();
     
     // Toggle selection state for a specific task
-    void toggle_task_selection(const std::string& task_id);
+    void toggle_task_selection(const TaskId& task_id);
+    void toggle_task_selection(TaskHandle handle);
     
     // Check if a task is currently selected
-    bool is_task_selected(const std::string& task_id) const;
+    bool is_task_selected(const TaskId& task_id) const;
+    bool is_task_selected(TaskHandle handle) const;
     
     // Clear all task selections
     void clear_selection();
+
+    // Select every task
+    void select_all();
+
+    // Select the tasks that are not selected and deselect the others
+    void invert_selection();
+
+    // Add every task with the given status to the selection
+    void select_by_status(bool done);
+
+    // Remove every task with the given status from the selection
+    void deselect_by_status(bool done);
+
+    // Select or deselect the tasks at positions [first, last] of a view
+    // (O(last - first), no id lookups; the view must be current)
+    void set_range_selected(const TaskView& view, size_t first, size_t last, bool selected);
+
+    // Flip the selection of every task in a view (O(view size); the view must be current)
+    void invert_view_selection(const TaskView& view);
+
+    // Deselect every task that is in neither view (O(view sizes); the views must be current)
+    // Used to confirm only what a filtered list shows.
+    void restrict_selection(const TaskView& first, const TaskView& second);
     
-    // Get list of IDs for all selected tasks
-    std::vector<std::string> get_selected_task_ids() const;
+    // Get list of IDs for all selected tasks (in slot order)
+    std::vector<TaskId> get_selected_task_ids() const;
     
-    // Check if any tasks are currently selected
+    // Check if any tasks are currently selected (O(1))
     bool has_selection() const;
+
+    // Number of selected tasks (O(1))
+    size_t get_selection_count() const;
 };
 
 #endif
\ No newline at end of file
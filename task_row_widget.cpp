@@ -0,0 +1,95 @@
+#include "imgui_internal.h"
+#include "task_row_widget.h"
+
+// Draw one selectable task row (same interaction as ImGui::Checkbox, fewer items)
+bool DrawTaskRowCheckbox(ImGuiID id, const char* text, const char* text_end, float* row_height, bool* selected) {
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    if (window->SkipItems) {
+        return false;
+    }
+
+    ImGuiContext& g = *GImGui;
+    const ImGuiStyle& style = g.Style;
+    const float box_size = ImGui::GetFrameHeight();
+    const ImVec2 pos = window->DC.CursorPos;
+
+    // Text starts after the box and wraps at the right edge of the column, like TextWrapped
+    const ImVec2 text_pos(pos.x + box_size + style.ItemInnerSpacing.x, pos.y + style.FramePadding.y);
+    const float wrap_width = ImMax(window->WorkRect.Max.x - text_pos.x, 1.0f);
+
+    // Measuring wrapped text walks it as far as drawing it does, so a height
+    // kept by the caller from an earlier frame skips that pass
+    float height = row_height != NULL ? *row_height : 0.0f;
+    if (height <= 0.0f) {
+        const ImVec2 text_size = ImGui::CalcTextSize(text, text_end, false, wrap_width);
+        height = ImMax(box_size, text_size.y + style.FramePadding.y * 2.0f) + style.ItemSpacing.y;
+        if (row_height != NULL) {
+            *row_height = height;
+        }
+    }
+
+    // One item for the whole row (the cursor advances by `height`: the row plus item spacing)
+    const ImRect row_bb(pos, ImVec2(ImMax(window->WorkRect.Max.x, text_pos.x), pos.y + height - style.ItemSpacing.y));
+    ImGui::ItemSize(row_bb, style.FramePadding.y);
+
+    // The hit box also covers the item spacing around the row (as Selectable does),
+    // so there is no dead gap between rows for clicks and box-select
+    ImRect hit_bb = row_bb;
+    const float spacing_above = IM_TRUNC(style.ItemSpacing.y * 0.5f);
+    hit_bb.Min.y -= spacing_above;
+    hit_bb.Max.y += style.ItemSpacing.y - spacing_above;
+    const bool is_visible = ImGui::ItemAdd(hit_bb, id);
+    const bool is_multi_select = (g.LastItemData.ItemFlags & ImGuiItemFlags_IsMultiSelect) != 0;
+    if (!is_visible) {
+        // A clipped row still takes part in an active box-select
+        if (!is_multi_select || !g.BoxSelectState.UnclipMode || !g.BoxSelectState.UnclipRect.Overlaps(hit_bb)) {
+            return false;
+        }
+    }
+
+    // Single hit-test, wrapped by the multi-select header/footer when in a scope
+    // (the header makes unselected rows press on mouse down, so a drag starting on a row box-selects)
+    bool checked = *selected;
+    ImGuiButtonFlags button_flags = ImGuiButtonFlags_None;
+    if (is_multi_select) {
+        ImGui::MultiSelectItemHeader(id, &checked, &button_flags);
+    }
+    bool hovered = false;
+    bool held = false;
+    bool pressed = ImGui::ButtonBehavior(hit_bb, id, &hovered, &held, button_flags);
+    if (is_multi_select) {
+        ImGui::MultiSelectItemFooter(id, &checked, &pressed);
+    } else if (pressed) {
+        checked = !checked;
+    }
+
+    bool changed = checked != *selected;
+    if (changed) {
+        *selected = checked;
+        ImGui::MarkItemEdited(id);
+    }
+
+    if (is_visible) {
+        ImDrawList* draw_list = window->DrawList;
+        ImGui::RenderNavCursor(hit_bb, id);
+
+        // Box (hover colors follow the whole row, since the whole row is the button)
+        const ImVec2 box_max(pos.x + box_size, pos.y + box_size);
+        ImGuiCol box_color = (held && hovered) ? ImGuiCol_FrameBgActive : hovered ? ImGuiCol_FrameBgHovered : ImGuiCol_FrameBg;
+        draw_list->AddRectFilled(pos, box_max, ImGui::GetColorU32(box_color), style.FrameRounding);
+        if (style.FrameBorderSize > 0.0f) {
+            draw_list->AddRect(pos, box_max, ImGui::GetColorU32(ImGuiCol_Border), style.FrameRounding, 0, style.FrameBorderSize);
+        }
+
+        // Tick
+        if (*selected) {
+            const float pad = ImMax(1.0f, IM_TRUNC(box_size / 6.0f));
+            ImGui::RenderCheckMark(draw_list, ImVec2(pos.x + pad, pos.y + pad), ImGui::GetColorU32(ImGuiCol_CheckMark),
+                                   box_size - pad * 2.0f);
+        }
+
+        // Text (ImFont::RenderText skips wrapped lines outside the clip rect)
+        draw_list->AddText(g.Font, g.FontSize, text_pos, ImGui::GetColorU32(ImGuiCol_Text), text, text_end, wrap_width);
+    }
+    return changed;
+}
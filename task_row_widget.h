@@ -0,0 +1,23 @@
+#ifndef TASK_ROW_WIDGET_H
+#define TASK_ROW_WIDGET_H
+
+#include "imgui.h"
+
+// Draw one selectable task row: checkbox and wrapped text as a single item
+//
+// Checkbox + SameLine + TextWrapped is three items per row, each with its own
+// layout and clipping bookkeeping, and the checkbox needs a string ID. This
+// widget takes a precomputed ID, lays out the row once, hit-tests it once and
+// draws the box, tick and text straight into the window's draw list. The whole
+// row is clickable and is what box-select tests against.
+//
+// `row_height` is the row's height including item spacing (the cursor advance).
+// Pass the value from an earlier frame at the same width to skip measuring the
+// wrapped text, or 0 to have it measured and stored; NULL measures every call.
+//
+// Inside a multi-select scope call ImGui::SetNextItemSelectionUserData() first;
+// the toggle then comes back as a selection request.
+// Returns true if `selected` changed.
+bool DrawTaskRowCheckbox(ImGuiID id, const char* text, const char* text_end, float* row_height, bool* selected);
+
+#endif
@@ -0,0 +1,614 @@
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include "task_storage.h"
+#include "mapped_file.h"
+#include "json.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using json = nlohmann::json;
+
+// Flush a file to the disk
+bool sync_file(const std::string& path) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    bool synced = FlushFileBuffers(file) != 0;
+    CloseHandle(file);
+    return synced;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+#endif
+}
+
+// Close a written snapshot file and make sure all of it reached the disk
+// The last buffered bytes are only written by close(), so errors are checked after it.
+static bool finish_snapshot_file(std::ofstream& file, const std::string& path) {
+    file.close();
+    if (file.fail()) {
+        std::cerr << "Error: Failed to write snapshot " << path << std::endl;
+        return false;
+    }
+    if (!sync_file(path)) {
+        std::cerr << "Error: Failed to flush snapshot " << path << " to disk" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Little-endian encoding helpers for the binary format
+static void put_u32(std::string& out, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static void put_u64(std::string& out, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+static uint32_t get_u32(const char* in) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; i++) {
+        value |= static_cast<uint32_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    }
+    return value;
+}
+
+static uint64_t get_u64(const char* in) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    }
+    return value;
+}
+
+// Choose snapshot format by file extension
+SnapshotFormat snapshot_format_for_path(const std::string& path) {
+    return std::filesystem::path(path).extension() == ".bin" ? SnapshotFormat::Binary : SnapshotFormat::Json;
+}
+
+// Detect snapshot format from the first bytes of the file
+SnapshotFormat detect_snapshot_format(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char signature[sizeof(binary_snapshot::magic)] = {};
+    if (file.read(signature, sizeof(signature)) &&
+        std::memcmp(signature, binary_snapshot::magic, sizeof(signature)) == 0) {
+        return SnapshotFormat::Binary;
+    }
+    return SnapshotFormat::Json;
+}
+
+// Read a snapshot, dispatching on its signature
+SnapshotStatus read_snapshot(const std::string& path, std::vector<Task>& tasks) {
+    if (!std::filesystem::exists(path)) {
+        return SnapshotStatus::Missing;
+    }
+
+    if (detect_snapshot_format(path) == SnapshotFormat::Binary) {
+        return read_binary_snapshot(path, tasks);
+    }
+    return read_json_snapshot(path, tasks);
+}
+
+// Write a snapshot in the given format
+bool write_snapshot_file(const std::string& path, const std::vector<Task>& tasks, SnapshotFormat format,
+                         JsonStyle style) {
+    if (format == SnapshotFormat::Binary) {
+        return write_binary_snapshot(path, tasks);
+    }
+    return write_json_snapshot(path, tasks, style);
+}
+
+// SAX handler that builds Task objects straight from JSON parser events,
+// without materializing the document as a json DOM first.
+// Expected shape: {"<id>": {"title": "<string>", "done": <bool>}, ...}
+class TaskSnapshotSaxHandler : public nlohmann::json_sax<json> {
+private:
+    std::vector<Task>& tasks;       // Destination for decoded tasks
+
+    size_t depth = 0;               // Nesting depth (1 = root object, 2 = task object)
+    std::string current_id;         // Key of the task being decoded
+    std::string current_field;      // Field name inside the task object
+
+    std::string title;              // Decoded title of the current task
+    bool done = false;              // Decoded status of the current task
+    bool has_title = false;         // "title" field seen
+    bool has_done = false;          // "done" field seen
+    std::string invalid_reason;     // Set when a field has the wrong type
+
+    // Handle a scalar value; `kind` names its type for error messages
+    bool value(const char* kind) {
+        if (depth == 0) {
+            invalid_structure = true;  // Root must be an object
+            return false;
+        }
+        if (depth == 1) {
+            skip_task();  // Task entry is not an object
+        }
+        if (depth == 2) {
+            field_type_mismatch(kind);
+        }
+        return true;  // Values nested deeper are ignored
+    }
+
+    // Record a type error for the required fields
+    void field_type_mismatch(const char* kind) {
+        if (current_field == "title") {
+            invalid_reason = std::string("title must be a string, got ") + kind;
+        } else if (current_field == "done") {
+            invalid_reason = std::string("done must be a boolean, got ") + kind;
+        }
+    }
+
+    // Warn about a task entry that has no usable fields
+    void skip_task() const {
+        std::cerr << "Warning: Skipping task " << current_id << " - missing required fields" << std::endl;
+    }
+
+    // Reset per-task state when a task object starts
+    void begin_task() {
+        title.clear();
+        done = false;
+        has_title = false;
+        has_done = false;
+        invalid_reason.clear();
+    }
+
+    // Emit the task once its object is closed
+    void end_task() {
+        if (!invalid_reason.empty()) {
+            std::cerr << "Warning: Skipping task " << current_id << " - invalid data: " << invalid_reason << std::endl;
+        } else if (!has_title || !has_done) {
+            skip_task();
+        } else {
+            tasks.emplace_back(TaskId::from_text(current_id), std::move(title), done);
+        }
+    }
+
+public:
+    bool invalid_structure = false;  // Root value was not an object
+    std::string error_message;       // Parser error, if any
+
+    // Constructor: Binds the handler to the output vector
+    explicit TaskSnapshotSaxHandler(std::vector<Task>& output) : tasks(output) {}
+
+    bool null() override { return value("null"); }
+    bool number_integer(number_integer_t) override { return value("number"); }
+    bool number_unsigned(number_unsigned_t) override { return value("number"); }
+    bool number_float(number_float_t, const string_t&) override { return value("number"); }
+    bool binary(binary_t&) override { return value("binary"); }
+
+    bool boolean(bool val) override {
+        if (depth == 2 && current_field == "done") {
+            done = val;
+            has_done = true;
+            return true;
+        }
+        return value("boolean");
+    }
+
+    bool string(string_t& val) override {
+        if (depth == 2 && current_field == "title") {
+            title = std::move(val);  // Take the parser's buffer instead of copying
+            has_title = true;
+            return true;
+        }
+        return value("string");
+    }
+
+    bool start_object(std::size_t) override {
+        if (depth == 1) {
+            begin_task();
+        } else if (depth == 2) {
+            field_type_mismatch("object");
+        }
+        depth++;
+        return true;
+    }
+
+    bool end_object() override {
+        depth--;
+        if (depth == 1) {
+            end_task();
+        }
+        return true;
+    }
+
+    bool start_array(std::size_t) override {
+        if (depth == 0) {
+            invalid_structure = true;  // Root must be an object
+            return false;
+        }
+        if (depth == 2) {
+            field_type_mismatch("array");
+        }
+        depth++;
+        return true;
+    }
+
+    bool end_array() override {
+        depth--;
+        if (depth == 1) {
+            skip_task();  // Task entry was an array
+        }
+        return true;
+    }
+
+    bool key(string_t& val) override {
+        if (depth == 1) {
+            current_id = std::move(val);
+        } else if (depth == 2) {
+            current_field = std::move(val);
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& ex) override {
+        error_message = ex.what();
+        return false;
+    }
+};
+
+// Read tasks from a JSON snapshot file with the streaming SAX parser
+SnapshotStatus read_json_snapshot(const std::string& path, std::vector<Task>& tasks) {
+    if (!std::filesystem::exists(path)) {
+        return SnapshotStatus::Missing;
+    }
+
+    std::error_code ec;
+    std::uintmax_t file_size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        std::cerr << "Error: Cannot open data file " << path << std::endl;
+        return SnapshotStatus::Error;
+    }
+
+    // Check if file is empty
+    if (file_size == 0) {
+        return SnapshotStatus::Empty;
+    }
+
+    // Pretty-printed records take roughly 100 bytes plus the title,
+    // so this reserves close to the final count without overshooting much
+    tasks.reserve(tasks.size() + static_cast<size_t>(file_size / 128));
+
+    TaskSnapshotSaxHandler handler(tasks);
+    bool parsed = false;
+
+    try {
+        MappedFile mapping;
+        if (mapping.open(path)) {
+            parsed = json::sax_parse(mapping.data(), mapping.data() + mapping.size(), &handler);
+        } else {
+            // Fall back to buffered stream input if the file cannot be mapped
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open()) {
+                std::cerr << "Error: Cannot open data file " << path << std::endl;
+                return SnapshotStatus::Error;
+            }
+            parsed = json::sax_parse(file, &handler);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading data from " << path << ": " << e.what() << std::endl;
+        return SnapshotStatus::Error;
+    }
+
+    if (handler.invalid_structure) {
+        std::cerr << "Warning: Invalid JSON structure in " << path << std::endl;
+        return SnapshotStatus::Invalid;
+    }
+
+    if (!parsed) {
+        // Handle JSON parsing errors
+        std::cerr << "Error: JSON parse error in " << path << ": " << handler.error_message << std::endl;
+        return SnapshotStatus::Invalid;
+    }
+
+    return SnapshotStatus::Ok;
+}
+
+// Length of the valid UTF-8 sequence starting at `text`, or 0 if it is invalid
+static size_t utf8_sequence_length(const unsigned char* text, size_t available) {
+    unsigned char lead = text[0];
+    size_t length = 0;
+    unsigned char min_next = 0x80;  // Allowed range of the second byte
+    unsigned char max_next = 0xBF;
+
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        length = 2;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        length = 3;
+        if (lead == 0xE0) min_next = 0xA0;  // Overlong encodings
+        if (lead == 0xED) max_next = 0x9F;  // UTF-16 surrogates
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        length = 4;
+        if (lead == 0xF0) min_next = 0x90;  // Overlong encodings
+        if (lead == 0xF4) max_next = 0x8F;  // Above U+10FFFF
+    } else {
+        return 0;
+    }
+
+    if (available < length || text[1] < min_next || text[1] > max_next) {
+        return 0;
+    }
+    for (size_t i = 2; i < length; i++) {
+        if (text[i] < 0x80 || text[i] > 0xBF) {
+            return 0;
+        }
+    }
+    return length;
+}
+
+// Append a quoted, escaped JSON string
+// Runs of characters that need no escaping are copied in one append
+void append_json_string(std::string& out, const std::string& text) {
+    static const char hex_digits[] = "0123456789abcdef";
+
+    const unsigned char* data = reinterpret_cast<const unsigned char*>(text.data());
+    const size_t length = text.size();
+    size_t run_start = 0;
+    size_t i = 0;
+
+    out.push_back('"');
+    while (i < length) {
+        unsigned char c = data[i];
+
+        // Plain printable ASCII: extend the current run
+        if (c >= 0x20 && c < 0x80 && c != '"' && c != '\\') {
+            i++;
+            continue;
+        }
+
+        // Valid multi-byte UTF-8 is copied verbatim
+        if (c >= 0x80) {
+            size_t sequence = utf8_sequence_length(data + i, length - i);
+            if (sequence != 0) {
+                i += sequence;
+                continue;
+            }
+        }
+
+        out.append(text, run_start, i - run_start);
+        switch (c) {
+            case '"':  out.append("\\\""); break;
+            case '\\': out.append("\\\\"); break;
+            case '\b': out.append("\\b"); break;
+            case '\f': out.append("\\f"); break;
+            case '\n': out.append("\\n"); break;
+            case '\r': out.append("\\r"); break;
+            case '\t': out.append("\\t"); break;
+            default:
+                if (c >= 0x80) {
+                    out.append("\\ufffd");  // Invalid UTF-8 byte
+                } else {
+                    out.append("\\u00");
+                    out.push_back(hex_digits[c >> 4]);
+                    out.push_back(hex_digits[c & 0x0F]);
+                }
+                break;
+        }
+        i++;
+        run_start = i;
+    }
+    out.append(text, run_start, length - run_start);
+    out.push_back('"');
+}
+
+// Write tasks to a JSON snapshot file
+bool write_json_snapshot(const std::string& path, const std::vector<Task>& tasks, JsonStyle style) {
+    constexpr size_t flush_threshold = 1 << 20;  // Write out every ~1 MiB
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot save to file " << path << std::endl;
+        return false;
+    }
+
+    const bool pretty = style == JsonStyle::Pretty;
+    std::string buffer;
+    buffer.reserve(flush_threshold + 4096);
+
+    if (tasks.empty()) {
+        buffer.append("{}");  // Same as json::dump() of an empty object
+    } else {
+        buffer.push_back('{');
+        bool first = true;
+        for (const Task& task : tasks) {
+            if (!first) {
+                buffer.push_back(',');
+            }
+            first = false;
+
+            // Fields are written in key order, matching json::dump() output
+            if (pretty) {
+                buffer.append("\n    \"");
+                task.id.append_to(buffer);  // Hex and dashes, never needs escaping
+                buffer.append("\": {\n        \"done\": ");
+                buffer.append(task.done ? "true" : "false");
+                buffer.append(",\n        \"title\": ");
+                append_json_string(buffer, task.title);
+                buffer.append("\n    }");
+            } else {
+                buffer.push_back('"');
+                task.id.append_to(buffer);
+                buffer.append("\":{\"done\":");
+                buffer.append(task.done ? "true" : "false");
+                buffer.append(",\"title\":");
+                append_json_string(buffer, task.title);
+                buffer.push_back('}');
+            }
+
+            if (buffer.size() >= flush_threshold) {
+                file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+                buffer.clear();
+            }
+        }
+        buffer.append(pretty ? "\n}" : "}");
+    }
+
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return finish_snapshot_file(file, path);
+}
+
+// Read tasks from a memory-mapped binary snapshot
+// (decoded in full: the task list and the search indexes need every title)
+SnapshotStatus read_binary_snapshot(const std::string& path, std::vector<Task>& tasks) {
+    if (!std::filesystem::exists(path)) {
+        return SnapshotStatus::Missing;
+    }
+
+    std::error_code ec;
+    if (std::filesystem::file_size(path, ec) == 0) {
+        return SnapshotStatus::Empty;
+    }
+
+    MappedFile mapping;
+    if (!mapping.open(path)) {
+        std::cerr << "Error: Cannot map data file " << path << std::endl;
+        return SnapshotStatus::Error;
+    }
+
+    const char* data = mapping.data();
+    const size_t size = mapping.size();
+
+    // Validate header
+    if (size < binary_snapshot::header_size ||
+        std::memcmp(data, binary_snapshot::magic, sizeof(binary_snapshot::magic)) != 0) {
+        std::cerr << "Warning: Invalid binary snapshot header in " << path << std::endl;
+        return SnapshotStatus::Invalid;
+    }
+
+    uint32_t version = get_u32(data + 4);
+    if (version != binary_snapshot::version && version != binary_snapshot::text_id_version) {
+        std::cerr << "Warning: Unsupported binary snapshot version " << version << " in " << path << std::endl;
+        return SnapshotStatus::Invalid;
+    }
+
+    uint64_t count = get_u64(data + 8);
+    uint64_t table_offset = get_u64(data + 16);
+    uint64_t records_offset = get_u64(data + 24);
+
+    // Offset table must fit between the header and the records
+    // (checked without sums or products, which a crafted header could overflow)
+    if (table_offset < binary_snapshot::header_size || table_offset > size || records_offset > size ||
+        records_offset < table_offset || count > (records_offset - table_offset) / 8) {
+        std::cerr << "Warning: Corrupted binary snapshot offset table in " << path << std::endl;
+        return SnapshotStatus::Invalid;
+    }
+
+    const char* table = data + table_offset;
+    const char* records = data + records_offset;
+    const size_t records_size = size - records_offset;
+
+    const bool text_ids = version == binary_snapshot::text_id_version;
+    const size_t record_header_size = text_ids ? binary_snapshot::text_id_record_header_size
+                                               : binary_snapshot::record_header_size;
+
+    // Every record takes at least its header, which bounds what the file can hold
+    tasks.reserve(tasks.size() + static_cast<size_t>(std::min<uint64_t>(count, records_size / record_header_size)));
+
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t position = get_u64(table + i * 8);
+        if (position > records_size || records_size - position < record_header_size) {
+            std::cerr << "Warning: Skipping task record " << i << " - offset out of range" << std::endl;
+            continue;
+        }
+
+        const char* record = records + position;
+        bool done = record[0] != 0;
+        size_t available = records_size - position - record_header_size;
+
+        TaskId id;
+        uint32_t id_length = 0;
+        uint32_t title_length = 0;
+        if (text_ids) {
+            id_length = get_u32(record + 1);
+            title_length = get_u32(record + 5);
+        } else {
+            id.high = get_u64(record + 1);
+            id.low = get_u64(record + 9);
+            title_length = get_u32(record + 17);
+        }
+
+        if (static_cast<uint64_t>(id_length) + title_length > available) {
+            std::cerr << "Warning: Skipping task record " << i << " - truncated data" << std::endl;
+            continue;
+        }
+
+        const char* id_text = record + record_header_size;
+        const char* title = id_text + id_length;
+        if (text_ids) {
+            id = TaskId::from_text(std::string(id_text, id_length));
+        }
+        tasks.emplace_back(id, std::string(title, title_length), done);
+    }
+
+    return SnapshotStatus::Ok;
+}
+
+// Write tasks to a binary snapshot file
+bool write_binary_snapshot(const std::string& path, const std::vector<Task>& tasks) {
+    const uint64_t count = tasks.size();
+    const uint64_t table_offset = binary_snapshot::header_size;
+    const uint64_t records_offset = table_offset + count * 8;
+
+    // Header and offset table
+    std::string head;
+    head.reserve(static_cast<size_t>(records_offset));
+    head.append(binary_snapshot::magic, sizeof(binary_snapshot::magic));
+    put_u32(head, binary_snapshot::version);
+    put_u64(head, count);
+    put_u64(head, table_offset);
+    put_u64(head, records_offset);
+
+    uint64_t position = 0;
+    for (const Task& task : tasks) {
+        put_u64(head, position);
+        position += binary_snapshot::record_header_size + task.title.size();
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot save to file " << path << std::endl;
+        return false;
+    }
+    file.write(head.data(), static_cast<std::streamsize>(head.size()));
+
+    // Packed records, written through a reusable buffer
+    std::string buffer;
+    buffer.reserve(1 << 20);
+    for (const Task& task : tasks) {
+        buffer.push_back(task.done ? 1 : 0);
+        put_u64(buffer, task.id.high);
+        put_u64(buffer, task.id.low);
+        put_u32(buffer, static_cast<uint32_t>(task.title.size()));
+        buffer.append(task.title);
+
+        if (buffer.size() >= (1 << 20)) {
+            file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return finish_snapshot_file(file, path);
+}
@@ -0,0 +1,89 @@
+#ifndef TASK_STORAGE_H
+#define TASK_STORAGE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "task.h"
+
+// On-disk snapshot encodings
+enum class SnapshotFormat {
+    Json,     // Human-editable JSON object keyed by task id
+    Binary    // Packed binary records, read through a memory mapping
+};
+
+// Layout of JSON snapshots
+enum class JsonStyle {
+    Pretty,   // 4-space indentation, one field per line (same layout as json::dump(4))
+    Compact   // No whitespace at all
+};
+
+// Outcome of reading a snapshot file
+enum class SnapshotStatus {
+    Ok,        // Snapshot read successfully
+    Missing,   // File does not exist
+    Empty,     // File exists but has no content
+    Invalid,   // File content is malformed
+    Error      // File could not be opened or read
+};
+
+// Binary snapshot layout (all integers little-endian):
+//
+//   header        magic "TMBS", u32 version, u64 task count,
+//                 u64 offset of the offset table, u64 offset of the records
+//   offset table  u64 per task, record position relative to the records start
+//   records       u8 done, u64 id high, u64 id low, u32 title length, title bytes
+//
+// The offset table allows random access to a single record without
+// decoding (or paging in) the ones before it. Version 1 files stored the
+// id as text (u8 done, u32 id length, u32 title length, id bytes, title
+// bytes) and are still readable.
+namespace binary_snapshot {
+    constexpr char magic[4] = {'T', 'M', 'B', 'S'};   // File signature
+    constexpr uint32_t version = 2;                   // Current layout version
+    constexpr uint32_t text_id_version = 1;           // Oldest readable version (text ids)
+    constexpr size_t header_size = 32;                // Bytes before the offset table
+    constexpr size_t record_header_size = 21;         // done + 128-bit id + title length
+    constexpr size_t text_id_record_header_size = 9;  // done + id length + title length (version 1)
+}
+
+// Pick the snapshot format from a file extension (".bin" selects binary)
+SnapshotFormat snapshot_format_for_path(const std::string& path);
+
+// Detect the format of an existing snapshot file from its signature
+SnapshotFormat detect_snapshot_format(const std::string& path);
+
+// Read a snapshot in either format (detected from the file signature)
+SnapshotStatus read_snapshot(const std::string& path, std::vector<Task>& tasks);
+
+// Flush a written and closed file from the OS cache to the disk
+// Called before a file is renamed over the one it replaces, so a crash cannot
+// leave a renamed but empty or truncated file. Returns false on failure.
+bool sync_file(const std::string& path);
+
+// Write a snapshot in the requested format (style only applies to JSON)
+bool write_snapshot_file(const std::string& path, const std::vector<Task>& tasks, SnapshotFormat format,
+                         JsonStyle style = JsonStyle::Pretty);
+
+// Read a JSON snapshot ({"<id>": {"title": ..., "done": ...}, ...})
+SnapshotStatus read_json_snapshot(const std::string& path, std::vector<Task>& tasks);
+
+// Write tasks as a JSON snapshot
+// Records are streamed through a fixed-size buffer, so no json DOM or
+// full-document string is built
+bool write_json_snapshot(const std::string& path, const std::vector<Task>& tasks,
+                         JsonStyle style = JsonStyle::Pretty);
+
+// Append `text` to `out` as a quoted JSON string
+// Invalid UTF-8 sequences are replaced with U+FFFD so the output always parses
+void append_json_string(std::string& out, const std::string& text);
+
+// Read a binary snapshot through a memory mapping
+// Every record is decoded into `tasks` at once; the mapping only saves copying
+// the file into a read buffer first.
+SnapshotStatus read_binary_snapshot(const std::string& path, std::vector<Task>& tasks);
+
+// Write tasks as a binary snapshot
+bool write_binary_snapshot(const std::string& path, const std::vector<Task>& tasks);
+
+#endif
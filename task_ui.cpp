@@ -0,0 +1,523 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include "task_ui.h"
+#include "task_row_widget.h"
+#include "frame_profiler.h"
+
+// Draw the visible part of a read-only task list (main window panels)
+void DrawTaskRows(const std::vector<TaskViewModel::Row>& rows, TaskListLayout& layout, uint64_t rows_version,
+                  FrameArena& arena) {
+    PROFILE_SCOPE("DrawTaskRows");
+
+    // Wrapped label, item spacing, 10px spacer and its item spacing
+    float estimated_height = ImGui::GetTextLineHeightWithSpacing() + 10 + ImGui::GetStyle().ItemSpacing.y;
+
+    size_t index = layout.begin(rows, rows_version, estimated_height);
+    for (; index < rows.size() && layout.in_view(); index++) {
+        float row_start = ImGui::GetCursorPosY();
+        // "N. title" is formatted into the frame arena; "%s" lets ImGui use the text without copying
+        ImGui::TextWrapped("%s", arena.format("%zu. %s", index + 1, rows[index].task->title.c_str()));
+        ImGui::Dummy(ImVec2(0, 10));  // Add spacing between tasks
+        layout.record_height(index, ImGui::GetCursorPosY() - row_start);
+    }
+    layout.end();
+}
+
+// Draw a search field that filters a view model
+void DrawTaskSearchBox(const char* id, char* buffer, size_t buffer_size, TaskViewModel& view_model,
+                       const TaskManager& task_manager) {
+    ImGui::SetNextItemWidth(-FLT_MIN);
+    ImGui::InputTextWithHint(id, "Search tasks", buffer, buffer_size);
+    view_model.set_filter(buffer);
+    view_model.refresh(task_manager);  // Searches only when the query or the tasks changed
+
+    if (view_model.is_filtered()) {
+        size_t matches = view_model.get_uncompleted_rows().size() + view_model.get_completed_rows().size();
+        ImGui::TextDisabled("%zu of %zu tasks match", matches, task_manager.task_count());
+    }
+}
+
+// Apply the selection requests of one modal list to the TaskManager selection
+// Requests cover whole ranges, so a shift+click or box-select over 100k rows is one pass over their slots
+static void apply_selection_requests(const ImGuiMultiSelectIO* io, const TaskManager::TaskView& view, bool completed,
+                                     bool filtered, TaskManager& task_manager) {
+    for (const ImGuiSelectionRequest& request : io->Requests) {
+        if (request.Type == ImGuiSelectionRequestType_SetAll && filtered) {
+            // The list only holds the search matches: select exactly those
+            task_manager.set_range_selected(view, 0, view.size(), request.Selected);
+        } else if (request.Type == ImGuiSelectionRequestType_SetAll) {
+            // Ctrl+A or a cleared box-select: the list holds every task with this status
+            if (request.Selected) {
+                task_manager.select_by_status(completed);
+            } else {
+                task_manager.deselect_by_status(completed);
+            }
+        } else if (request.Type == ImGuiSelectionRequestType_SetRange) {
+            size_t first = static_cast<size_t>(std::min(request.RangeFirstItem, request.RangeLastItem));
+            size_t last = static_cast<size_t>(std::max(request.RangeFirstItem, request.RangeLastItem));
+            task_manager.set_range_selected(view, first, last, request.Selected);
+        }
+    }
+}
+
+// Draw one row of a selection list: the whole row is the multi-select item
+// `row_height` is the layout's cached height (0 = measure); returns the height used
+static float draw_selectable_row(const TaskViewModel::Row& row, size_t index, float row_height,
+                                 TaskManager& task_manager, FrameArena& arena) {
+    // Widget ID from the slot index, which is unique among live tasks: one integer hash, no ID stack push
+    ImGuiID id = ImGui::GetID(static_cast<int>(row.handle.index));
+    bool selected = task_manager.is_task_selected(row.handle);  // Bit test, no id lookup
+    ImGui::SetNextItemSelectionUserData(static_cast<ImGuiSelectionUserData>(index));
+    const char* label = arena.format("%zu. %s", index + 1, row.task->title.c_str());
+    DrawTaskRowCheckbox(id, label, NULL, &row_height, &selected);  // Changes come back as selection requests
+    return row_height;
+}
+
+// Draw the visible part of a task list with selection checkboxes (selection modals)
+void DrawSelectableTaskRows(const TaskViewModel& view_model, bool completed, TaskListLayout& layout,
+                            TaskManager& task_manager, FrameArena& arena) {
+    PROFILE_SCOPE("DrawSelectableTaskRows");
+
+    const std::vector<TaskViewModel::Row>& rows = completed ? view_model.get_completed_rows()
+                                                            : view_model.get_uncompleted_rows();
+    const TaskManager::TaskView& view = completed ? view_model.get_completed_view()
+                                                  : view_model.get_uncompleted_view();
+    float estimated_height = ImGui::GetFrameHeightWithSpacing();  // One line next to a checkbox
+
+    // Checkbox list: a click toggles one task, shift+click selects a range,
+    // ctrl+A selects the whole list and dragging from empty space box-selects
+    ImGuiMultiSelectFlags flags = ImGuiMultiSelectFlags_NoAutoSelect | ImGuiMultiSelectFlags_NoAutoClear |
+                                  ImGuiMultiSelectFlags_BoxSelect1d;
+    ImGuiMultiSelectIO* io = ImGui::BeginMultiSelect(flags, -1, static_cast<int>(rows.size()));
+    apply_selection_requests(io, view, completed, view_model.is_filtered(), task_manager);
+
+    // The range anchor must be submitted every frame or ImGui drops it, so it
+    // is also drawn when scrolled away (at its own position, where it is clipped)
+    size_t anchor = SIZE_MAX;
+    if (io->RangeSrcItem >= 0 && static_cast<size_t>(io->RangeSrcItem) < rows.size()) {
+        anchor = static_cast<size_t>(io->RangeSrcItem);
+    }
+
+    size_t index = layout.begin(rows, view_model.get_rows_version(), estimated_height);
+    if (anchor < index) {
+        float first_row_y = ImGui::GetCursorPosY();
+        ImGui::SetCursorPosY(layout.get_row_y(anchor));
+        draw_selectable_row(rows[anchor], anchor, layout.get_measured_height(anchor), task_manager, arena);
+        ImGui::SetCursorPosY(first_row_y);
+    }
+
+    // Rows measure their text only until the layout has their height at this width
+    for (; index < rows.size() && layout.in_view(); index++) {
+        float height = draw_selectable_row(rows[index], index, layout.get_measured_height(index), task_manager, arena);
+        layout.record_height(index, height);
+    }
+
+    if (anchor != SIZE_MAX && anchor >= index) {
+        ImGui::SetCursorPosY(layout.get_row_y(anchor));
+        draw_selectable_row(rows[anchor], anchor, layout.get_measured_height(anchor), task_manager, arena);
+    }
+    layout.end();
+
+    io = ImGui::EndMultiSelect();
+    apply_selection_requests(io, view, completed, view_model.is_filtered(), task_manager);
+}
+
+// Function to draw a modal for task selection (marking or deletion)
+// Returns true if user confirms the action, false otherwise
+bool DrawTaskSelectionModal(
+    const char* title,              // Modal title
+    const char* confirm_button_text,// Text for confirm button
+    TaskManager& task_manager,      // Reference to task manager
+    TaskViewModel& view_model,      // Cached rows (filtered by the search field)
+    char* search_buffer,            // Search field input
+    size_t search_buffer_size,      // Size of the search field input
+    TaskListLayouts& layouts,       // Virtualized layouts of both columns
+    FrameArena& arena,              // Storage for this frame's row labels
+    bool& show_modal_flag)          // Flag to control modal visibility
+{
+    PROFILE_SCOPE("DrawTaskSelectionModal");
+    bool result = false;            // Return value indicating user action
+    
+    // Open modal when flag is set
+    if (show_modal_flag) {
+        ImGui::OpenPopup(title);
+        task_manager.init_selection_states();  // Initialize selection states
+        show_modal_flag = false;               // Reset flag after opening
+    }
+
+    // Set modal position and size
+    ImGui::SetNextWindowPos(ImGui::GetMainViewport()->GetCenter(), ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+    ImGui::SetNextWindowSize(ImVec2(750, 600), ImGuiCond_FirstUseEver);
+
+    // Begin modal popup
+    if (ImGui::BeginPopupModal(title, NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoScrollbar)) {
+        // Start with every task listed
+        if (ImGui::IsWindowAppearing()) {
+            search_buffer[0] = '\0';
+        }
+
+        // Close modal on Escape key press
+        if (ImGui::IsKeyPressed(ImGuiKey_Escape)) {
+            task_manager.clear_selection();  // Clear any selections
+            ImGui::CloseCurrentPopup();      // Close modal
+        }
+
+        // Center the title text
+        ImGui::SetCursorPosX((ImGui::GetWindowWidth() - ImGui::CalcTextSize(title).x) * 0.5f);
+        ImGui::Text("%s", title);
+        ImGui::Separator();
+
+        // Search field (rows are rebuilt from the title index when the query changes)
+        DrawTaskSearchBox("##modal_search", search_buffer, search_buffer_size, view_model, task_manager);
+
+        // Bulk selection (each is a pass over the selection bitset, not over the tasks)
+        // While searching they only act on the listed matches
+        const bool filtered = view_model.is_filtered();
+        const TaskManager::TaskView& uncompleted = view_model.get_uncompleted_view();
+        const TaskManager::TaskView& completed = view_model.get_completed_view();
+        if (ImGui::SmallButton("Select All")) {
+            if (filtered) {
+                task_manager.set_range_selected(uncompleted, 0, uncompleted.size(), true);
+                task_manager.set_range_selected(completed, 0, completed.size(), true);
+            } else {
+                task_manager.select_all();
+            }
+        }
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Select Completed")) {
+            if (filtered) {
+                task_manager.set_range_selected(completed, 0, completed.size(), true);
+            } else {
+                task_manager.select_by_status(true);
+            }
+        }
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Invert")) {
+            if (filtered) {
+                task_manager.invert_view_selection(uncompleted);
+                task_manager.invert_view_selection(completed);
+            } else {
+                task_manager.invert_selection();
+            }
+        }
+        ImGui::SameLine();
+        if (ImGui::SmallButton("Clear")) {
+            task_manager.clear_selection();
+        }
+        ImGui::SameLine();
+        ImGui::TextDisabled("%zu of %zu selected", task_manager.get_selection_count(), task_manager.task_count());
+        
+        // Calculate content area height (remaining space minus button area)
+        float content_height = ImGui::GetContentRegionAvail().y - 50;
+        ImGui::BeginChild("ContentArea", ImVec2(0, content_height), false, ImGuiWindowFlags_NoScrollbar);
+        
+        // Create two columns for uncompleted and completed tasks
+        ImGui::Columns(2, "task_columns", true);
+        float column_width = (ImGui::GetWindowWidth() - ImGui::GetStyle().ItemSpacing.x) * 0.5f;
+        ImGui::SetColumnWidth(0, column_width);  // Set left column width
+        ImGui::SetColumnWidth(1, column_width);  // Set right column width
+
+        // Left column: Uncompleted tasks
+        ImGui::BeginChild("LeftColumn", ImVec2(0, 0), false);
+        ImGui::TextColored(ImVec4(1, 0.5f, 0.5f, 1), "To Complete");
+        ImGui::Separator();
+        
+        // Scrollable area for uncompleted tasks
+        ImGui::BeginChild("LeftScroll", ImVec2(0, -1), true, ImGuiWindowFlags_AlwaysVerticalScrollbar);
+        view_model.refresh(task_manager);  // Rebuilds rows only if tasks changed
+
+        // Display visible uncompleted tasks with checkboxes
+        DrawSelectableTaskRows(view_model, false, layouts.uncompleted, task_manager, arena);
+        ImGui::EndChild();  // End LeftScroll
+        ImGui::EndChild();  // End LeftColumn
+
+        // Right column: Completed tasks
+        ImGui::NextColumn();
+        ImGui::BeginChild("RightColumn", ImVec2(0, 0), false);
+        ImGui::TextColored(ImVec4(0.5f, 1, 0.5f, 1), "Completed");
+        ImGui::Separator();
+        
+        // Scrollable area for completed tasks
+        ImGui::BeginChild("RightScroll", ImVec2(0, -1), true, ImGuiWindowFlags_AlwaysVerticalScrollbar);
+
+        // Display visible completed tasks with checkboxes
+        DrawSelectableTaskRows(view_model, true, layouts.completed, task_manager, arena);
+        ImGui::EndChild();  // End RightScroll
+        ImGui::EndChild();  // End RightColumn
+
+        ImGui::Columns(1);  // Reset to single column
+        ImGui::EndChild();  // End ContentArea
+        ImGui::Separator();
+        
+        // Button area at the bottom of the modal
+        ImGui::BeginChild("ButtonArea", ImVec2(0, 0), false);
+        
+        // Check if any tasks are selected
+        bool has_selection = task_manager.has_selection();
+
+        // Calculate button positioning
+        float button_width = 100;
+        float spacing = ImGui::GetStyle().ItemSpacing.x;
+        float total_width = button_width * 2 + spacing;
+        float start_x = (ImGui::GetWindowWidth() - total_width) * 0.5f;
+        
+        ImGui::SetCursorPosY(ImGui::GetCursorPosY() + 5);  // Add vertical spacing
+        
+        // Disable confirm button if no tasks are selected
+        if (!has_selection) {
+            ImGui::BeginDisabled();
+        }
+        
+        ImGui::SetCursorPosX(start_x);
+        
+        // Confirm button - performs the action (mark/delete)
+        if (ImGui::Button(confirm_button_text, ImVec2(button_width, 30))) {
+            if (view_model.is_filtered()) {
+                // Act only on the listed matches: tasks selected before the query changed stay untouched
+                task_manager.restrict_selection(uncompleted, completed);
+            }
+            result = true;  // User confirmed the action
+            ImGui::CloseCurrentPopup();  // Close modal
+        }  
+        
+        if (!has_selection) {
+            ImGui::EndDisabled();
+        }
+        
+        ImGui::SameLine();
+        
+        // Cancel button - closes modal without action
+        if (ImGui::Button("Cancel", ImVec2(button_width, 30))) {
+            task_manager.clear_selection();  // Clear selections
+            ImGui::CloseCurrentPopup();      // Close modal
+        }
+        
+        ImGui::EndChild();  // End ButtonArea
+        ImGui::EndPopup();  // End modal
+    }
+    
+    return result;  // Return whether user confirmed the action
+}
+
+// Build the fullscreen main window with its three panels and all modals
+void DrawMainWindow(TaskManager& task_manager, TaskViewModel& view_model, AppState& state, const ImVec2& window_size) {
+    PROFILE_SCOPE("DrawMainWindow");
+    state.frame_arena.reset();  // Labels of the previous frame are no longer referenced
+
+    // Create main application window (fullscreen)
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(window_size);
+    ImGui::Begin("MainWindow", nullptr, 
+        ImGuiWindowFlags_NoTitleBar | 
+        ImGuiWindowFlags_NoResize | 
+        ImGuiWindowFlags_NoMove);
+
+    // Calculate panel widths with margins
+    float margin = 20.0f;
+    float panel_width = (window_size.x - 3 * margin) / 3;
+    
+    // Left panel: Control buttons
+    ImGui::BeginChild("LeftPanel", ImVec2(panel_width, -1), true);
+    
+    ImGui::Text("Control Panel");
+    ImGui::Separator();
+    ImGui::Dummy(ImVec2(0, 10));  // Add spacing
+    
+    // Button to mark tasks as complete/incomplete
+    if (ImGui::Button("Mark Task", ImVec2(-1, 0))) {
+        state.show_mark_task_modal = true;  // Show mark task modal
+    }
+    ImGui::Dummy(ImVec2(0, 10));
+    
+    // Button to add new task
+    if (ImGui::Button("Add New Task", ImVec2(-1, 0))) {
+        state.show_add_task_modal = true;  // Show add task modal
+        state.task_input_buffer[0] = '\0'; // Clear input buffer
+        state.task_input_focused = true;   // Set focus flag
+    }
+    ImGui::Dummy(ImVec2(0, 10));
+    
+    // Button to delete tasks
+    if (ImGui::Button("Delete Task", ImVec2(-1, 0))) {
+        state.show_mark_delete_task_modal = true;  // Show delete task modal
+    }
+    ImGui::Dummy(ImVec2(0, 10));
+    
+    // Exit button
+    if (ImGui::Button("Exit", ImVec2(-1, 0))) {
+        state.exit_requested = true;  // Close application (handled by the caller)
+    }
+    ImGui::Dummy(ImVec2(0, 10));
+
+    // Search field filtering both task panels
+    DrawTaskSearchBox("##panel_search", state.panel_search, IM_ARRAYSIZE(state.panel_search), view_model, task_manager);
+    
+    ImGui::EndChild();  // End LeftPanel
+
+    ImGui::SameLine(0, margin);  // Move to next panel with margin
+
+    // Center panel: Uncompleted tasks list
+    ImGui::BeginChild("CenterPanel", ImVec2(panel_width, -1), true, ImGuiWindowFlags_AlwaysVerticalScrollbar);
+
+    ImGui::TextColored(ImVec4(1, 0.5f, 0.5f, 1), "Uncompleted Tasks");
+    ImGui::Separator();
+    ImGui::Dummy(ImVec2(0, 10));
+
+    // Get and display uncompleted tasks (cached rows, labels formatted only for visible rows)
+    view_model.refresh(task_manager);
+    const std::vector<TaskViewModel::Row>& uncompleted_rows = view_model.get_uncompleted_rows();
+
+    if (uncompleted_rows.empty()) {
+        ImGui::Text("%s", view_model.is_filtered() ? "No matching tasks" : "No uncompleted tasks information");
+    } else {
+        // Only rows inside the viewport are submitted
+        DrawTaskRows(uncompleted_rows, state.panel_layouts.uncompleted, view_model.get_rows_version(), state.frame_arena);
+    }
+
+    ImGui::EndChild();  // End CenterPanel
+
+    ImGui::SameLine(0, margin);  // Move to next panel with margin
+
+    // Right panel: Completed tasks list
+    ImGui::BeginChild("RightPanel", ImVec2(panel_width, -1), true, ImGuiWindowFlags_AlwaysVerticalScrollbar);
+
+    ImGui::TextColored(ImVec4(0.5f, 1, 0.5f, 1), "Completed Tasks");
+    ImGui::Separator();
+    ImGui::Dummy(ImVec2(0, 10));
+
+    // Get and display completed tasks (cached rows, labels formatted only for visible rows)
+    const std::vector<TaskViewModel::Row>& completed_rows = view_model.get_completed_rows();
+
+    if (completed_rows.empty()) {
+        ImGui::Text("%s", view_model.is_filtered() ? "No matching tasks" : "No completed tasks");
+    } else {
+        // Only rows inside the viewport are submitted
+        DrawTaskRows(completed_rows, state.panel_layouts.completed, view_model.get_rows_version(), state.frame_arena);
+    }
+
+    ImGui::EndChild();  // End RightPanel
+
+    // Handle mark task modal
+    if (state.show_mark_task_modal) {
+        ImGui::OpenPopup("Mark Tasks");
+        state.show_mark_task_modal = false;
+    }
+
+    // If user confirms marking tasks, toggle their status
+    if (DrawTaskSelectionModal("Mark Tasks", "Confirm", task_manager, state.modal_view_model, state.modal_search,
+                               IM_ARRAYSIZE(state.modal_search), state.modal_layouts, state.frame_arena,
+                               state.show_mark_task_modal)) {
+        auto selected_ids = task_manager.get_selected_task_ids();
+        task_manager.begin_batch();  // Persist all changes with a single write
+        for (const TaskId& task_id : selected_ids) {
+            task_manager.toggle_task_status(task_id);  // Toggle completion status
+        }
+        task_manager.commit_batch();
+        task_manager.clear_selection();  // Clear selection after operation
+    }
+
+    // Handle delete task modal
+    if (state.show_mark_delete_task_modal) {
+        ImGui::OpenPopup("Delete Tasks");
+        state.show_mark_delete_task_modal = false;
+    }
+
+    // If user confirms deletion, delete selected tasks
+    if (DrawTaskSelectionModal("Delete Tasks", "Confirm", task_manager, state.modal_view_model, state.modal_search,
+                               IM_ARRAYSIZE(state.modal_search), state.modal_layouts, state.frame_arena,
+                               state.show_mark_delete_task_modal)) {
+        auto selected_ids = task_manager.get_selected_task_ids();
+        task_manager.begin_batch();  // Persist all changes with a single write
+        for (const TaskId& task_id : selected_ids) {
+            task_manager.delete_task(task_id);  // Delete task
+        }
+        task_manager.commit_batch();
+        task_manager.clear_selection();  // Clear selection after operation
+    }
+
+    // Handle add task modal
+    if (state.show_add_task_modal) {
+        ImGui::OpenPopup("Add New Task");
+        state.show_add_task_modal = false;
+    }
+
+    // Position add task modal in center of screen
+    ImVec2 center = ImGui::GetMainViewport()->GetCenter();
+    ImGui::SetNextWindowPos(center, ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
+
+    // Add new task modal
+    if (ImGui::BeginPopupModal("Add New Task", NULL, ImGuiWindowFlags_AlwaysAutoResize)) {
+        // Close modal on Escape key
+        if (ImGui::IsKeyPressed(ImGuiKey_Escape)) {
+            ImGui::CloseCurrentPopup();
+            state.task_input_buffer[0] = '\0';  // Clear input buffer
+        }
+
+        ImGui::Text("Enter task name:");
+        
+        // Set keyboard focus to input field if requested
+        if (state.task_input_focused) {
+            ImGui::SetKeyboardFocusHere();
+            state.task_input_focused = false;
+        }
+        
+        // Input text field for new task name
+        if (ImGui::InputText("##task_input", state.task_input_buffer, IM_ARRAYSIZE(state.task_input_buffer), 
+                            ImGuiInputTextFlags_EnterReturnsTrue)) {
+            // Add task when Enter is pressed and input is not empty
+            if (strlen(state.task_input_buffer) > 0) {
+                std::string task_string = state.task_input_buffer;
+                task_manager.add_task(task_string);  // Add new task
+                ImGui::CloseCurrentPopup();          // Close modal
+            }
+        }
+        
+        ImGui::Separator();
+        
+        // Center the buttons
+        float width = ImGui::GetContentRegionAvail().x;
+        ImGui::SetCursorPosX((width - 200) * 0.5f);
+        
+        // Disable confirm button if input is empty
+        if (strlen(state.task_input_buffer) == 0) {
+            ImGui::BeginDisabled();
+        }
+        
+        // Confirm button to add task
+        if (ImGui::Button("Confirm", ImVec2(80, 0))) {
+            std::string task_string = state.task_input_buffer;
+            task_manager.add_task(task_string);  // Add new task
+            ImGui::CloseCurrentPopup();          // Close modal
+        }
+        
+        if (strlen(state.task_input_buffer) == 0) {
+            ImGui::EndDisabled();
+        }
+        
+        ImGui::SameLine();
+        
+        // Cancel button to close modal without adding task
+        if (ImGui::Button("Cancel", ImVec2(80, 0))) {
+            ImGui::CloseCurrentPopup();
+        }
+        
+        ImGui::EndPopup();  // End add task modal
+    }
+
+    ImGui::End();  // End MainWindow
+
+    // Frame profiler window, toggled with F3
+    if (ImGui::IsKeyPressed(ImGuiKey_F3, false)) {
+        state.profiler_window.open = !state.profiler_window.open;
+    }
+    DrawFrameProfilerWindow(state.profiler_window);
+}
+
+// Check if the UI needs frames without input
+bool NeedsContinuousRendering(const AppState& state) {
+    const ImGuiIO& io = ImGui::GetIO();
+    bool profiler_live = state.profiler_window.open && !state.profiler_window.paused;
+    return ImGui::IsAnyMouseDown() || io.WantTextInput || profiler_live;
+}
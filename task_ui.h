@@ -0,0 +1,75 @@
+#ifndef TASK_UI_H
+#define TASK_UI_H
+
+#include <vector>
+#include <cstdint>
+#include "imgui.h"
+#include "task_manager.h"
+#include "task_view_model.h"
+#include "task_list_layout.h"
+#include "frame_arena.h"
+#include "frame_profiler_window.h"
+
+// Virtualized layouts for a pair of uncompleted/completed task lists
+struct TaskListLayouts {
+    TaskListLayout uncompleted;     // Layout of the uncompleted list
+    TaskListLayout completed;       // Layout of the completed list
+};
+
+// Application state structure to manage UI modal states and input buffers
+struct AppState {
+    bool show_add_task_modal = false;           // Flag to show/hide add task modal
+    bool show_mark_task_modal = false;          // Flag to show/hide mark task modal
+    bool show_mark_delete_task_modal = false;   // Flag to show/hide delete task modal
+    
+    char task_input_buffer[256] = "";           // Buffer for storing new task input
+    bool task_input_focused = false;            // Flag to focus on task input field
+
+    bool exit_requested = false;                // Set when the Exit button is pressed
+
+    FrameProfilerWindowState profiler_window;   // Frame profiler window (F3)
+
+    FrameArena frame_arena;                     // Per-frame strings, reset by DrawMainWindow()
+
+    TaskListLayouts panel_layouts;              // Row heights of the main window panels
+    TaskListLayouts modal_layouts;              // Row heights of the selection modals (only one is open at a time)
+
+    char panel_search[128] = "";                // Search query of the main window panels
+    char modal_search[128] = "";                // Search query of the open selection modal
+    TaskViewModel modal_view_model;             // Rows of the selection modals (filtered by modal_search)
+};
+
+// Draw the visible part of a read-only task list (main window panels)
+// `rows_version` is TaskViewModel::get_rows_version() (cached heights are dropped when it changes)
+void DrawTaskRows(const std::vector<TaskViewModel::Row>& rows, TaskListLayout& layout, uint64_t rows_version,
+                  FrameArena& arena);
+
+// Draw a search field that filters a view model, with the number of matching tasks below it
+void DrawTaskSearchBox(const char* id, char* buffer, size_t buffer_size, TaskViewModel& view_model,
+                       const TaskManager& task_manager);
+
+// Draw the visible part of a task list with selection checkboxes (selection modals)
+// The list is an ImGui multi-select scope: shift+click ranges, ctrl+A and box-select
+// are applied to the TaskManager selection as whole ranges (only the rows shown
+// when the view model is filtered by a search)
+void DrawSelectableTaskRows(const TaskViewModel& view_model, bool completed, TaskListLayout& layout,
+                            TaskManager& task_manager, FrameArena& arena);
+
+// Function to draw a modal for task selection (marking or deletion)
+// Returns true if user confirms the action, false otherwise
+// While the search field filters the lists, confirming first deselects the
+// tasks the search hides, so the action only covers what is listed.
+bool DrawTaskSelectionModal(const char* title, const char* confirm_button_text, TaskManager& task_manager,
+                            TaskViewModel& view_model, char* search_buffer, size_t search_buffer_size,
+                            TaskListLayouts& layouts, FrameArena& arena, bool& show_modal_flag);
+
+// Build one frame of the application UI (panels and modals) between
+// ImGui::NewFrame() and ImGui::Render(). Needs no window or renderer, so the
+// same code runs in the application and in headless benchmarks.
+void DrawMainWindow(TaskManager& task_manager, TaskViewModel& view_model, AppState& state, const ImVec2& window_size);
+
+// Check if the last frame has something that changes without input
+// (held mouse buttons, an active text field's caret, the live profiler graph)
+bool NeedsContinuousRendering(const AppState& state);
+
+#endif
@@ -0,0 +1,72 @@
+#include "task_view_model.h"
+#include "frame_profiler.h"
+
+// Rebuild the cached rows if the task set or the filter changed since the last refresh
+void TaskViewModel::refresh(const TaskManager& task_manager) {
+    uint64_t generation = task_manager.get_generation();
+    if (generation == built_generation && filter == built_filter) {
+        return;  // Nothing changed, keep cached rows
+    }
+    PROFILE_SCOPE("TaskViewModel::refresh");
+
+    if (filter.empty()) {
+        uncompleted_view = task_manager.uncompleted_view();
+        completed_view = task_manager.completed_view();
+    } else {
+        task_manager.search_titles(filter, search);
+        uncompleted_view = task_manager.search_view(search, false);
+        completed_view = task_manager.search_view(search, true);
+    }
+    build_rows(uncompleted_view, uncompleted_rows);
+    build_rows(completed_view, completed_rows);
+    built_generation = generation;
+    built_filter = filter;
+    rows_version++;
+}
+
+// Set the search filter
+void TaskViewModel::set_filter(const char* query) {
+    if (filter != query) {
+        filter = query;
+    }
+}
+
+// Check if a search filter is applied
+bool TaskViewModel::is_filtered() const {
+    return !built_filter.empty();
+}
+
+// Fill rows with task pointers and handles
+void TaskViewModel::build_rows(const TaskManager::TaskView& view, std::vector<Row>& rows) {
+    rows.resize(view.size());
+
+    for (size_t i = 0; i < view.size(); i++) {
+        rows[i].task = &view[i];
+        rows[i].handle = view.handle_at(i);
+    }
+}
+
+// Get cached uncompleted rows
+const std::vector<TaskViewModel::Row>& TaskViewModel::get_uncompleted_rows() const {
+    return uncompleted_rows;
+}
+
+// Get cached completed rows
+const std::vector<TaskViewModel::Row>& TaskViewModel::get_completed_rows() const {
+    return completed_rows;
+}
+
+// Get the view behind the uncompleted rows
+const TaskManager::TaskView& TaskViewModel::get_uncompleted_view() const {
+    return uncompleted_view;
+}
+
+// Get the view behind the completed rows
+const TaskManager::TaskView& TaskViewModel::get_completed_view() const {
+    return completed_view;
+}
+
+// Get the version of the cached rows
+uint64_t TaskViewModel::get_rows_version() const {
+    return rows_version;
+}
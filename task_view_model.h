@@ -0,0 +1,75 @@
+#ifndef TASK_VIEW_MODEL_H
+#define TASK_VIEW_MODEL_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "task_manager.h"
+
+// Render-ready task lists for the UI
+// Rows are rebuilt only when the TaskManager generation or the search filter
+// changes, so frames without edits do no work proportional to the task count.
+// Labels ("N. title") are not stored; the visible rows format them into the
+// frame arena.
+class TaskViewModel {
+public:
+    // One displayed task
+    struct Row {
+        const Task* task = nullptr;   // Task in TaskManager storage (valid until the next mutation)
+        TaskHandle handle;            // Stable reference to the same task
+    };
+
+private:
+    // Generation the rows were built from (UINT64_MAX = never built)
+    uint64_t built_generation = UINT64_MAX;
+
+    // Search filter ("" = every task) and the filter the rows were built with
+    std::string filter;
+    std::string built_filter;
+
+    // Matches of the filter (storage behind the views when filtering)
+    TitleSearchResult search;
+
+    // Bumped on every rebuild (layouts key their cached heights on it)
+    uint64_t rows_version = 0;
+
+    // Cached rows for both partitions
+    std::vector<Row> uncompleted_rows;
+    std::vector<Row> completed_rows;
+
+    // Views the rows were built from (row i is position i; same lifetime as the rows)
+    TaskManager::TaskView uncompleted_view;
+    TaskManager::TaskView completed_view;
+
+    // Rebuild rows for one view
+    static void build_rows(const TaskManager::TaskView& view, std::vector<Row>& rows);
+
+public:
+    // Bring the cached rows up to date; O(1) when nothing changed
+    // Call before reading rows in any code that may run after a mutation
+    void refresh(const TaskManager& task_manager);
+
+    // Show only the tasks whose title contains `query` (ASCII case-insensitive)
+    // An empty query shows every task; takes effect at the next refresh()
+    void set_filter(const char* query);
+
+    // Check if the rows are filtered by a search
+    bool is_filtered() const;
+
+    // Cached rows of uncompleted tasks
+    const std::vector<Row>& get_uncompleted_rows() const;
+
+    // Cached rows of completed tasks
+    const std::vector<Row>& get_completed_rows() const;
+
+    // View behind the uncompleted rows (for bulk operations on row ranges)
+    const TaskManager::TaskView& get_uncompleted_view() const;
+
+    // View behind the completed rows
+    const TaskManager::TaskView& get_completed_view() const;
+
+    // Changes whenever the rows are rebuilt (task changes or a new filter)
+    uint64_t get_rows_version() const;
+};
+
+#endif
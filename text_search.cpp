@@ -0,0 +1,247 @@
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include "text_search.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define TEXT_SEARCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TEXT_SEARCH_AVX2_TARGET
+#else
+#define TEXT_SEARCH_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+// Lowercase one ASCII byte
+static inline char fold_byte(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// Lowercase the ASCII letters of a string
+std::string fold_ascii_case(const std::string& text) {
+    std::string folded = text;
+    for (char& c : folded) {
+        c = fold_byte(c);
+    }
+    return folded;
+}
+
+// Compare `length` bytes of text against a folded query
+static inline bool matches_folded(const char* text, const char* folded_query, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (fold_byte(text[i]) != folded_query[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Byte loop: find the first query byte, then compare the rest
+static size_t find_scalar(const char* text, size_t length, const char* query, size_t query_length) {
+    const char first = query[0];
+    const size_t last_start = length - query_length;
+    for (size_t start = 0; start <= last_start; start++) {
+        if (fold_byte(text[start]) == first && matches_folded(text + start + 1, query + 1, query_length - 1)) {
+            return start;
+        }
+    }
+    return std::string::npos;
+}
+
+#ifdef TEXT_SEARCH_X86
+
+// Scratch block for the last, partial step of a text (largest vector plus a query)
+static const size_t padded_block_size = 128;
+
+// OR mask that folds a text byte for comparison with a folded query byte:
+// for a lowercase letter q, (c | 0x20) == q exactly when c is q in either case
+static inline char fold_mask_for(char query_byte) {
+    return (query_byte >= 'a' && query_byte <= 'z') ? 0x20 : 0;
+}
+
+// 16 start positions per step (SSE2, part of x86-64)
+static size_t find_sse2(const char* text, size_t length, const char* query, size_t query_length) {
+    const size_t width = 16;
+    const size_t starts = length - query_length + 1;        // Positions a match can start at
+    const size_t last_offset = query_length - 1;
+    const size_t middle_length = query_length > 2 ? query_length - 2 : 0;
+
+    const __m128i first = _mm_set1_epi8(query[0]);
+    const __m128i last = _mm_set1_epi8(query[last_offset]);
+    const __m128i first_fold = _mm_set1_epi8(fold_mask_for(query[0]));
+    const __m128i last_fold = _mm_set1_epi8(fold_mask_for(query[last_offset]));
+    alignas(16) char padded[padded_block_size];
+
+    size_t position = 0;
+    while (position < starts) {
+        const char* block = text + position;
+        uint32_t valid = 0xFFFF;
+        if (position + width > starts) {
+            if (length >= width + last_offset) {
+                // Step back so the last block ends at the end of the text (rechecks a few starts)
+                position = starts - width;
+                block = text + position;
+            } else if (width + last_offset <= padded_block_size) {
+                // Shorter than one step: load from a zero-padded copy, ignore starts past the end
+                std::memset(padded, 0, width + last_offset);
+                std::memcpy(padded, text + position, length - position);
+                block = padded;
+                valid = (1u << (starts - position)) - 1;
+            } else {
+                size_t found = find_scalar(text + position, length - position, query, query_length);
+                return found == std::string::npos ? found : position + found;
+            }
+        }
+
+        __m128i head = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block)), first_fold);
+        __m128i tail = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + last_offset)), last_fold);
+        __m128i both = _mm_and_si128(_mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last));
+        uint32_t candidates = static_cast<uint32_t>(_mm_movemask_epi8(both)) & valid;
+        while (candidates != 0) {
+            size_t start = position + static_cast<size_t>(std::countr_zero(candidates));
+            if (matches_folded(text + start + 1, query + 1, middle_length)) {
+                return start;
+            }
+            candidates &= candidates - 1;
+        }
+        position += width;
+    }
+    return std::string::npos;
+}
+
+// 32 start positions per step (AVX2)
+TEXT_SEARCH_AVX2_TARGET
+static size_t find_avx2(const char* text, size_t length, const char* query, size_t query_length) {
+    const size_t width = 32;
+    const size_t starts = length - query_length + 1;
+    const size_t last_offset = query_length - 1;
+    const size_t middle_length = query_length > 2 ? query_length - 2 : 0;
+
+    const __m256i first = _mm256_set1_epi8(query[0]);
+    const __m256i last = _mm256_set1_epi8(query[last_offset]);
+    const __m256i first_fold = _mm256_set1_epi8(fold_mask_for(query[0]));
+    const __m256i last_fold = _mm256_set1_epi8(fold_mask_for(query[last_offset]));
+    alignas(32) char padded[padded_block_size];
+
+    size_t position = 0;
+    while (position < starts) {
+        const char* block = text + position;
+        uint32_t valid = 0xFFFFFFFFu;
+        if (position + width > starts) {
+            if (length >= width + last_offset) {
+                position = starts - width;
+                block = text + position;
+            } else if (width + last_offset <= padded_block_size) {
+                std::memset(padded, 0, width + last_offset);
+                std::memcpy(padded, text + position, length - position);
+                block = padded;
+                valid = (1u << (starts - position)) - 1;
+            } else {
+                size_t found = find_scalar(text + position, length - position, query, query_length);
+                return found == std::string::npos ? found : position + found;
+            }
+        }
+
+        __m256i head = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)), first_fold);
+        __m256i tail = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + last_offset)),
+                                       last_fold);
+        __m256i both = _mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last));
+        uint32_t candidates = static_cast<uint32_t>(_mm256_movemask_epi8(both)) & valid;
+        while (candidates != 0) {
+            size_t start = position + static_cast<size_t>(std::countr_zero(candidates));
+            if (matches_folded(text + start + 1, query + 1, middle_length)) {
+                return start;
+            }
+            candidates &= candidates - 1;
+        }
+        position += width;
+    }
+    return std::string::npos;
+}
+
+// Check if the CPU and the OS support AVX2
+static bool cpu_has_avx2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool os_saves_ymm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+    __cpuidex(info, 7, 0);
+    return os_saves_ymm && (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();  // Needed when called before main() (static initialization)
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+// Pick the fastest supported kernel
+TextSearchKernel get_best_text_search_kernel() {
+#ifdef TEXT_SEARCH_X86
+    static const bool has_avx2 = cpu_has_avx2();
+    return has_avx2 ? TextSearchKernel::Avx2 : TextSearchKernel::Sse2;
+#else
+    return TextSearchKernel::Scalar;
+#endif
+}
+
+static std::atomic<TextSearchKernel> active_kernel{get_best_text_search_kernel()};
+
+// Get the kernel in use
+TextSearchKernel get_text_search_kernel() {
+    return active_kernel.load(std::memory_order_relaxed);
+}
+
+// Switch kernels if supported
+bool set_text_search_kernel(TextSearchKernel kernel) {
+    TextSearchKernel best = get_best_text_search_kernel();
+    if (static_cast<int>(kernel) > static_cast<int>(best)) {
+        return false;  // Kernels are ordered: every kernel up to the best one is supported
+    }
+    active_kernel.store(kernel, std::memory_order_relaxed);
+    return true;
+}
+
+// Get the name of a kernel
+const char* get_text_search_kernel_name(TextSearchKernel kernel) {
+    switch (kernel) {
+        case TextSearchKernel::Scalar: return "scalar";
+        case TextSearchKernel::Sse2: return "sse2";
+        case TextSearchKernel::Avx2: return "avx2";
+    }
+    return "?";
+}
+
+// Case-insensitive substring search with the active kernel
+size_t find_folded(const char* text, size_t length, const std::string& folded_query) {
+    const size_t query_length = folded_query.size();
+    if (query_length == 0) {
+        return 0;
+    }
+    if (query_length > length) {
+        return std::string::npos;
+    }
+
+    switch (active_kernel.load(std::memory_order_relaxed)) {
+#ifdef TEXT_SEARCH_X86
+        case TextSearchKernel::Avx2:
+            return find_avx2(text, length, folded_query.data(), query_length);
+        case TextSearchKernel::Sse2:
+            return find_sse2(text, length, folded_query.data(), query_length);
+#endif
+        default:
+            return find_scalar(text, length, folded_query.data(), query_length);
+    }
+}
+
+// Case-insensitive substring test on a string
+bool contains_folded(const std::string& text, const std::string& folded_query) {
+    return find_folded(text.data(), text.size(), folded_query) != std::string::npos;
+}
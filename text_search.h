@@ -0,0 +1,52 @@
+#ifndef TEXT_SEARCH_H
+#define TEXT_SEARCH_H
+
+#include <string>
+#include <cstddef>
+
+// Case-insensitive substring search over UTF-8 text
+//
+// Only ASCII letters are folded; every other byte must match exactly. UTF-8
+// never uses ASCII bytes inside a multi-byte character and no character's
+// encoding starts inside another's, so a byte match of a valid UTF-8 query is
+// always a match of whole characters (non-ASCII letters match in their
+// exact case only).
+//
+// The vector kernels test the first and the last byte of the query at 16 or
+// 32 positions per step and compare the rest only where both match, so text
+// is mostly read one block at a time instead of one byte at a time. Texts
+// shorter than a block are copied into a padded block rather than falling
+// back to the byte loop, since task titles are usually that short.
+
+// Implementations of find_folded()
+enum class TextSearchKernel {
+    Scalar,     // Byte loop (any CPU)
+    Sse2,       // 16 bytes per step (every x86-64 CPU)
+    Avx2        // 32 bytes per step (chosen at runtime if the CPU has AVX2)
+};
+
+// Copy of `text` with ASCII letters lowercased (other bytes are kept, so UTF-8 stays valid)
+std::string fold_ascii_case(const std::string& text);
+
+// Offset of the first occurrence of `folded_query` in `text` ignoring ASCII
+// case, or std::string::npos. `folded_query` must already be folded with
+// fold_ascii_case().
+size_t find_folded(const char* text, size_t length, const std::string& folded_query);
+
+// Check if `text` contains `folded_query` ignoring ASCII case
+bool contains_folded(const std::string& text, const std::string& folded_query);
+
+// Fastest kernel this CPU and build support
+TextSearchKernel get_best_text_search_kernel();
+
+// Kernel used by find_folded() (the best one unless changed)
+TextSearchKernel get_text_search_kernel();
+
+// Use another kernel (for benchmarks and comparisons)
+// Returns false and keeps the current kernel if this CPU or build does not support it.
+bool set_text_search_kernel(TextSearchKernel kernel);
+
+// Kernel name for output
+const char* get_text_search_kernel_name(TextSearchKernel kernel);
+
+#endif
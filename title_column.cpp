@@ -0,0 +1,112 @@
+#include <algorithm>
+#include "title_column.h"
+#include "text_search.h"
+
+// Append a title
+void TitleColumn::insert(uint32_t slot, const std::string& title) {
+    remove(slot);  // Renames append the new title and drop the old one
+
+    if (slot >= entry_of_slot.size()) {
+        entry_of_slot.resize(static_cast<size_t>(slot) + 1, UINT32_MAX);
+    }
+    entry_of_slot[slot] = static_cast<uint32_t>(entry_slots.size());
+    entry_starts.push_back(bytes.size());
+    entry_slots.push_back(slot);
+    bytes.append(title);
+    bytes.push_back('\0');
+}
+
+// Blank out a title
+void TitleColumn::remove(uint32_t slot) {
+    if (slot >= entry_of_slot.size() || entry_of_slot[slot] == UINT32_MAX) {
+        return;
+    }
+
+    const uint32_t entry = entry_of_slot[slot];
+    const size_t start = entry_starts[entry];
+    const size_t end = entry + 1 < entry_starts.size() ? entry_starts[entry + 1] : bytes.size();
+    std::fill(bytes.begin() + static_cast<std::ptrdiff_t>(start), bytes.begin() + static_cast<std::ptrdiff_t>(end), '\0');
+    entry_slots[entry] = UINT32_MAX;
+    entry_of_slot[slot] = UINT32_MAX;
+    removed_bytes += end - start;
+
+    if (removed_bytes * 2 > bytes.size()) {
+        compact();  // Amortized: at least half the buffer is reclaimed
+    }
+}
+
+// Move the live entries together
+void TitleColumn::compact() {
+    size_t write = 0;
+    size_t kept = 0;
+    for (size_t entry = 0; entry < entry_slots.size(); entry++) {
+        if (entry_slots[entry] == UINT32_MAX) {
+            continue;
+        }
+        const size_t start = entry_starts[entry];
+        const size_t end = entry + 1 < entry_starts.size() ? entry_starts[entry + 1] : bytes.size();
+        std::copy(bytes.begin() + static_cast<std::ptrdiff_t>(start), bytes.begin() + static_cast<std::ptrdiff_t>(end),
+                  bytes.begin() + static_cast<std::ptrdiff_t>(write));
+        entry_starts[kept] = write;
+        entry_slots[kept] = entry_slots[entry];
+        entry_of_slot[entry_slots[kept]] = static_cast<uint32_t>(kept);
+        write += end - start;
+        kept++;
+    }
+    bytes.resize(write);
+    entry_starts.resize(kept);
+    entry_slots.resize(kept);
+    removed_bytes = 0;
+}
+
+// Drop every title
+void TitleColumn::clear() {
+    bytes.clear();
+    entry_starts.clear();
+    entry_slots.clear();
+    entry_of_slot.clear();
+    removed_bytes = 0;
+}
+
+// Scan the buffer for a query
+bool TitleColumn::find(const std::string& folded_query, std::vector<uint32_t>& out) const {
+    if (folded_query.find('\0') != std::string::npos) {
+        return false;
+    }
+
+    const size_t entry_count = entry_starts.size();
+    size_t position = 0;
+    size_t entry = 0;
+    while (position < bytes.size()) {
+        size_t found = find_folded(bytes.data() + position, bytes.size() - position, folded_query);
+        if (found == std::string::npos) {
+            break;
+        }
+        found += position;
+
+        // Entry holding the match: usually one of the next few, so probe before a binary search
+        size_t probe = entry + 1;
+        while (probe < entry_count && probe < entry + 8 && entry_starts[probe] <= found) {
+            probe++;
+        }
+        if (probe < entry_count && entry_starts[probe] <= found) {
+            probe = static_cast<size_t>(std::upper_bound(entry_starts.begin() + static_cast<std::ptrdiff_t>(probe),
+                                                         entry_starts.end(), found) - entry_starts.begin());
+        }
+        entry = probe - 1;
+
+        // Removed entries are all '\0', so the match is a live title (an empty
+        // query matches every entry, including removed ones)
+        if (entry_slots[entry] != UINT32_MAX) {
+            out.push_back(entry_slots[entry]);
+        }
+        position = entry + 1 < entry_count ? entry_starts[entry + 1] : bytes.size();
+    }
+    return true;
+}
+
+// Sum the storage of the buffer and the tables
+size_t TitleColumn::get_memory_bytes() const {
+    return bytes.capacity() + entry_starts.capacity() * sizeof(size_t) +
+           (entry_slots.capacity() + entry_of_slot.capacity()) * sizeof(uint32_t);
+}
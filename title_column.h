@@ -0,0 +1,51 @@
+#ifndef TITLE_COLUMN_H
+#define TITLE_COLUMN_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Every task title in one contiguous buffer, for substring scans
+//
+// Tasks keep their titles in separate strings, so scanning them reads one
+// heap block per task and spends most of its time waiting on memory. The
+// column copies the titles end to end, each followed by a '\0', so a scan is
+// one pass of the vector kernel (text_search.h) over the buffer. A match is
+// mapped back to its title through the sorted title offsets, and the scan
+// continues after that title.
+//
+// Removed titles are overwritten with '\0' bytes, which no query can match,
+// and the buffer is compacted once removed text makes up half of it.
+class TitleColumn {
+private:
+    std::string bytes;                      // Titles in insertion order, each followed by '\0'
+    std::vector<size_t> entry_starts;       // Offset of each entry in bytes (increasing)
+    std::vector<uint32_t> entry_slots;      // Slot of each entry (UINT32_MAX = removed)
+    std::vector<uint32_t> entry_of_slot;    // Slot -> entry index (UINT32_MAX = none)
+    size_t removed_bytes = 0;               // Bytes of removed entries
+
+    // Drop removed entries from the buffer
+    void compact();
+
+public:
+    // Append the title of `slot` (replaces the slot's previous title, if any)
+    void insert(uint32_t slot, const std::string& title);
+
+    // Remove the title of `slot`
+    void remove(uint32_t slot);
+
+    // Remove every title
+    void clear();
+
+    // Append the slots whose title contains `folded_query` (ASCII case-insensitive,
+    // already folded) to `out`, in insertion order
+    // Returns false without scanning if the query contains '\0', which the
+    // buffer uses as a separator; the caller must then check the titles itself.
+    bool find(const std::string& folded_query, std::vector<uint32_t>& out) const;
+
+    // Bytes used by the buffer and the entry tables
+    size_t get_memory_bytes() const;
+};
+
+#endif
@@ -0,0 +1,175 @@
+#include <fstream>
+#include <iostream>
+#include "trace_recorder.h"
+#include "json.hpp"
+
+using json = nlohmann::json;
+
+thread_local TraceRecorder::ThreadSlot TraceRecorder::thread_slot;
+
+// Nanoseconds since the clock's epoch
+static int64_t to_ns(TraceRecorder::clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+// Hand the buffer back when its thread exits (events stay readable until the next capture)
+TraceRecorder::ThreadSlot::~ThreadSlot() {
+    if (buffer != nullptr) {
+        TraceRecorder& recorder = TraceRecorder::instance();
+        std::lock_guard<std::mutex> lock(recorder.registry_mutex);
+        buffer->in_use = false;
+    }
+}
+
+// Buffer of the calling thread, registering it on first use
+TraceRecorder::ThreadBuffer& TraceRecorder::get_thread_buffer() {
+    if (thread_slot.buffer != nullptr) {
+        return *thread_slot.buffer;
+    }
+
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    uint64_t current = session.load(std::memory_order_relaxed);
+
+    // Reuse the buffer of an exited thread unless it holds events of the current capture
+    for (const auto& buffer : buffers) {
+        if (!buffer->in_use && (buffer->session.load(std::memory_order_relaxed) != current ||
+                                buffer->count.load(std::memory_order_relaxed) == 0)) {
+            buffer->in_use = true;
+            buffer->session.store(0, std::memory_order_relaxed);  // Reset on the first event
+            buffer->name = "Thread " + std::to_string(buffer->thread_id);
+            thread_slot.buffer = buffer.get();
+            return *buffer;
+        }
+    }
+
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->thread_id = static_cast<uint32_t>(buffers.size() + 1);
+    buffer->name = "Thread " + std::to_string(buffer->thread_id);
+    thread_slot.buffer = buffer.get();
+    buffers.push_back(std::move(buffer));
+    return *thread_slot.buffer;
+}
+
+// Discard the previous capture and start recording
+void TraceRecorder::start_capture() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    capture_start_ns = to_ns(clock::now());
+    session.fetch_add(1, std::memory_order_release);  // Writers reset their buffers on their next event
+    capturing.store(true, std::memory_order_release);
+}
+
+// Stop recording
+void TraceRecorder::stop_capture() {
+    capturing.store(false, std::memory_order_release);
+}
+
+// Continue a stopped capture
+void TraceRecorder::resume_capture() {
+    capturing.store(true, std::memory_order_release);
+}
+
+// Append one complete event to the calling thread's buffer
+void TraceRecorder::record(const char* name, clock::time_point start, clock::time_point end) {
+    ThreadBuffer& buffer = get_thread_buffer();
+
+    uint64_t current = session.load(std::memory_order_acquire);  // Orders the reset after earlier exports
+    if (buffer.session.load(std::memory_order_relaxed) != current) {
+        buffer.count.store(0, std::memory_order_relaxed);  // First event of a new capture on this thread
+        buffer.dropped.store(0, std::memory_order_relaxed);
+        buffer.session.store(current, std::memory_order_release);
+    }
+
+    if (!buffer.events) {
+        buffer.events = std::make_unique<Event[]>(events_per_thread);  // Published by the count store below
+    }
+
+    size_t index = buffer.count.load(std::memory_order_relaxed);
+    if (index == events_per_thread) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Event& event = buffer.events[index];
+    event.name = name;
+    event.start_ns = to_ns(start);
+    event.duration_ns = to_ns(end) - event.start_ns;
+    buffer.count.store(index + 1, std::memory_order_release);  // Publish the event to write_chrome_trace()
+}
+
+// Name the calling thread in exported traces
+void TraceRecorder::set_thread_name(const std::string& name) {
+    ThreadBuffer& buffer = get_thread_buffer();
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    buffer.name = name;
+}
+
+// Number of events in the current capture
+size_t TraceRecorder::get_event_count() const {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    uint64_t current = session.load(std::memory_order_relaxed);
+    size_t total = 0;
+    for (const auto& buffer : buffers) {
+        if (buffer->session.load(std::memory_order_acquire) == current) {
+            total += buffer->count.load(std::memory_order_acquire);
+        }
+    }
+    return total;
+}
+
+// Number of events dropped in the current capture
+size_t TraceRecorder::get_dropped_count() const {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    uint64_t current = session.load(std::memory_order_relaxed);
+    size_t total = 0;
+    for (const auto& buffer : buffers) {
+        if (buffer->session.load(std::memory_order_acquire) == current) {
+            total += buffer->dropped.load(std::memory_order_relaxed);
+        }
+    }
+    return total;
+}
+
+// Write the capture as {"traceEvents": [...]} with one "X" event per zone
+bool TraceRecorder::write_chrome_trace(const std::string& path) const {
+    json events = json::array();
+    size_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        uint64_t current = session.load(std::memory_order_relaxed);
+
+        for (const auto& buffer : buffers) {
+            if (buffer->session.load(std::memory_order_acquire) != current) {
+                continue;  // Thread recorded nothing in this capture
+            }
+
+            events.push_back({{"ph", "M"}, {"name", "thread_name"}, {"pid", 1}, {"tid", buffer->thread_id},
+                              {"args", {{"name", buffer->name}}}});
+
+            size_t count = buffer->count.load(std::memory_order_acquire);
+            for (size_t i = 0; i < count; i++) {
+                const Event& event = buffer->events[i];
+                events.push_back({{"ph", "X"}, {"name", event.name}, {"pid", 1}, {"tid", buffer->thread_id},
+                                  {"ts", static_cast<double>(event.start_ns - capture_start_ns) / 1000.0},
+                                  {"dur", static_cast<double>(event.duration_ns) / 1000.0}});
+            }
+            dropped += buffer->dropped.load(std::memory_order_relaxed);
+        }
+    }
+
+    json trace;
+    trace["traceEvents"] = std::move(events);
+    trace["displayTimeUnit"] = "ms";
+    trace["otherData"] = {{"dropped_events", dropped}};
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cerr << "Error: Cannot open trace file " << path << std::endl;
+        return false;
+    }
+    file << trace.dump();
+    if (!file) {
+        std::cerr << "Error: Cannot write trace file " << path << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,109 @@
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Timeline capture of timed zones on all threads, exported as a Chrome trace
+//
+// Every PROFILE_SCOPE zone (and every frame) records one complete event
+// while a capture is running. Each thread appends to its own fixed-size
+// buffer with no locks; the only lock is taken the first time a thread
+// records. A full buffer drops further events (counted) instead of growing.
+// Buffers of exited threads are reused once their events are no longer
+// part of the current capture.
+// Outside a capture a zone pays one relaxed atomic load.
+//
+// Usage:
+//     TraceRecorder::instance().start_capture();
+//     ...run...
+//     TraceRecorder::instance().stop_capture();
+//     TraceRecorder::instance().write_chrome_trace("trace.json");  // Open in ui.perfetto.dev or chrome://tracing
+class TraceRecorder {
+public:
+    static constexpr size_t events_per_thread = 1 << 16;   // 1.5 MB per recording thread
+
+    using clock = std::chrono::steady_clock;
+
+    // One timed zone
+    struct Event {
+        const char* name = nullptr;     // Static string (zone name)
+        int64_t start_ns = 0;           // clock time since its epoch
+        int64_t duration_ns = 0;
+    };
+
+private:
+    // Events of one thread (written only by that thread)
+    struct ThreadBuffer {
+        uint32_t thread_id = 0;                 // Small sequential id shown as "tid"
+        std::string name;                       // Display name (guarded by registry_mutex)
+        std::unique_ptr<Event[]> events;        // Allocated on the first recorded event
+        std::atomic<size_t> count{0};           // Published events (release by the writer)
+        std::atomic<size_t> dropped{0};         // Events lost because the buffer was full
+        std::atomic<uint64_t> session{0};       // Capture the events belong to
+        bool in_use = true;                     // Owned by a live thread (guarded by registry_mutex)
+    };
+
+    // Binding of a thread to its buffer; releases the buffer for reuse when the thread exits
+    struct ThreadSlot {
+        ThreadBuffer* buffer = nullptr;
+        ~ThreadSlot();
+    };
+
+    std::atomic<bool> capturing{false};
+    std::atomic<uint64_t> session{0};           // Incremented by every start_capture()
+    int64_t capture_start_ns = 0;               // Timestamps are written relative to this
+
+    mutable std::mutex registry_mutex;          // Guards buffers and thread names
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    static thread_local ThreadSlot thread_slot;    // Buffer of the calling thread
+
+    TraceRecorder() = default;
+
+    // Buffer of the calling thread, registering it on first use
+    ThreadBuffer& get_thread_buffer();
+
+public:
+    // The process-wide recorder
+    static TraceRecorder& instance() {
+        static TraceRecorder recorder;
+        return recorder;
+    }
+
+    // Check if events are being recorded
+    bool is_capturing() const { return capturing.load(std::memory_order_relaxed); }
+
+    // Discard the previous capture and start recording
+    void start_capture();
+
+    // Stop recording (events already recorded are kept for writing)
+    void stop_capture();
+
+    // Continue a stopped capture, appending to its events
+    void resume_capture();
+
+    // Record a zone that ran on the calling thread from `start` to `end`
+    void record(const char* name, clock::time_point start, clock::time_point end);
+
+    // Name the calling thread in exported traces
+    void set_thread_name(const std::string& name);
+
+    // Number of events in the current capture
+    size_t get_event_count() const;
+
+    // Number of events dropped because a thread buffer was full
+    size_t get_dropped_count() const;
+
+    // Write the capture in Chrome trace event format (call after stop_capture())
+    // Returns false on I/O error
+    bool write_chrome_trace(const std::string& path) const;
+};
+
+#endif
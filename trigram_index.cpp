@@ -0,0 +1,226 @@
+#include <algorithm>
+#include <array>
+#include "trigram_index.h"
+
+// Alphabet code of every byte: 0-25 letters, 26-35 digits, 36 space, 37-63 shared by all other bytes
+static constexpr std::array<uint8_t, 256> make_byte_codes() {
+    std::array<uint8_t, 256> codes{};
+    for (int byte = 0; byte < 256; byte++) {
+        if (byte >= 'a' && byte <= 'z') {
+            codes[byte] = static_cast<uint8_t>(byte - 'a');
+        } else if (byte >= 'A' && byte <= 'Z') {
+            codes[byte] = static_cast<uint8_t>(byte - 'A');
+        } else if (byte >= '0' && byte <= '9') {
+            codes[byte] = static_cast<uint8_t>(26 + byte - '0');
+        } else if (byte == ' ') {
+            codes[byte] = 36;
+        } else {
+            codes[byte] = static_cast<uint8_t>(37 + byte % 27);
+        }
+    }
+    return codes;
+}
+
+static constexpr std::array<uint8_t, 256> byte_codes = make_byte_codes();
+static constexpr uint8_t first_shared_code = 37;
+
+// Keep the elements of `out` that are also in `list` (both sorted)
+// Galloping search: O(m log(n / m)) for m = out.size(), n = list.size(),
+// so a short list intersected with a long one never walks the long one.
+static void intersect_galloping(std::vector<uint32_t>& out, const std::vector<uint32_t>& list) {
+    const size_t count = list.size();
+    size_t kept = 0;
+    size_t position = 0;    // Every element of `list` before this is smaller than the current slot
+
+    for (uint32_t slot : out) {
+        size_t step = 1;
+        while (position + step < count && list[position + step] < slot) {
+            step *= 2;
+        }
+        auto last = list.begin() + static_cast<std::ptrdiff_t>(std::min(count, position + step + 1));
+        position = static_cast<size_t>(std::lower_bound(list.begin() + static_cast<std::ptrdiff_t>(position), last, slot) -
+                                       list.begin());
+        if (position == count) {
+            break;
+        }
+        if (list[position] == slot) {
+            out[kept++] = slot;
+        }
+    }
+    out.resize(kept);
+}
+
+// Collect the sorted, distinct trigram keys of a text
+void TrigramIndex::collect_keys(const std::string& text) {
+    key_scratch.clear();
+    for (size_t i = 0; i + 2 < text.size(); i++) {
+        uint32_t key = static_cast<uint32_t>(byte_codes[static_cast<uint8_t>(text[i])]) << 12 |
+                       static_cast<uint32_t>(byte_codes[static_cast<uint8_t>(text[i + 1])]) << 6 |
+                       static_cast<uint32_t>(byte_codes[static_cast<uint8_t>(text[i + 2])]);
+        key_scratch.push_back(key);
+    }
+    std::sort(key_scratch.begin(), key_scratch.end());
+    key_scratch.erase(std::unique(key_scratch.begin(), key_scratch.end()), key_scratch.end());
+}
+
+// Merge queued inserts and removals into the sorted slots
+// A slot can be removed and inserted again (slot reuse) before a merge, so
+// membership is counted: in slots + times added - times removed.
+void TrigramIndex::merge_pending(PostingList& list) {
+    if (list.added.empty() && list.removed.empty()) {
+        return;
+    }
+    std::sort(list.added.begin(), list.added.end());
+    std::sort(list.removed.begin(), list.removed.end());
+
+    merge_scratch.clear();
+    merge_scratch.reserve(list.slots.size() + list.added.size());
+    size_t i = 0;
+    size_t j = 0;
+    size_t k = 0;
+    while (i < list.slots.size() || j < list.added.size()) {
+        uint32_t slot = j == list.added.size() || (i < list.slots.size() && list.slots[i] < list.added[j])
+                            ? list.slots[i] : list.added[j];
+        int count = 0;
+        for (; i < list.slots.size() && list.slots[i] == slot; i++) {
+            count++;
+        }
+        for (; j < list.added.size() && list.added[j] == slot; j++) {
+            count++;
+        }
+        for (; k < list.removed.size() && list.removed[k] < slot; k++) {
+        }
+        for (; k < list.removed.size() && list.removed[k] == slot; k++) {
+            count--;
+        }
+        if (count > 0) {
+            merge_scratch.push_back(slot);
+        }
+    }
+
+    list.slots.swap(merge_scratch);
+    list.added.clear();
+    list.removed.clear();
+}
+
+// Add a text's trigrams to the index
+void TrigramIndex::insert(uint32_t slot, const std::string& text) {
+    if (list_of_key.empty()) {
+        list_of_key.assign(key_count, UINT32_MAX);
+    }
+
+    collect_keys(text);
+    for (uint32_t key : key_scratch) {
+        uint32_t& list_index = list_of_key[key];
+        if (list_index == UINT32_MAX) {
+            list_index = static_cast<uint32_t>(lists.size());
+            lists.emplace_back();
+        }
+
+        PostingList& list = lists[list_index];
+        bool in_order = list.added.empty() && list.removed.empty() && (list.slots.empty() || slot > list.slots.back());
+        if (in_order) {
+            list.slots.push_back(slot);  // Common case: the newest slot
+        } else {
+            list.added.push_back(slot);
+            if (list.added.size() + list.removed.size() > 64 + list.slots.size() / 2) {
+                merge_pending(list);  // Bound the queue (amortized O(1) per insert)
+            }
+        }
+    }
+}
+
+// Remove a text's trigrams from the index
+void TrigramIndex::remove(uint32_t slot, const std::string& text) {
+    if (list_of_key.empty()) {
+        return;
+    }
+
+    collect_keys(text);
+    for (uint32_t key : key_scratch) {
+        uint32_t list_index = list_of_key[key];
+        if (list_index == UINT32_MAX) {
+            continue;  // Never inserted
+        }
+
+        PostingList& list = lists[list_index];
+        if (list.added.empty() && list.removed.empty() && !list.slots.empty() && list.slots.back() == slot) {
+            list.slots.pop_back();  // Undoing the newest insert
+        } else {
+            list.removed.push_back(slot);
+            if (list.added.size() + list.removed.size() > 64 + list.slots.size() / 2) {
+                merge_pending(list);
+            }
+        }
+    }
+}
+
+// Drop all lists and the key table
+void TrigramIndex::clear() {
+    list_of_key.clear();
+    lists.clear();
+}
+
+// Intersect the posting lists of the query's trigrams, shortest first
+bool TrigramIndex::find_candidates(const std::string& query, std::vector<uint32_t>& out) {
+    out.clear();
+    if (query.size() < 3) {
+        return false;
+    }
+    if (list_of_key.empty()) {
+        return true;  // Nothing indexed
+    }
+
+    collect_keys(query);
+    list_scratch.clear();
+    for (uint32_t key : key_scratch) {
+        uint32_t list_index = list_of_key[key];
+        if (list_index == UINT32_MAX) {
+            return true;  // No text has this trigram
+        }
+        PostingList& list = lists[list_index];
+        merge_pending(list);
+        if (list.slots.empty()) {
+            return true;
+        }
+        list_scratch.push_back(&list);
+    }
+
+    std::sort(list_scratch.begin(), list_scratch.end(),
+              [](const PostingList* a, const PostingList* b) { return a->slots.size() < b->slots.size(); });
+    out.assign(list_scratch[0]->slots.begin(), list_scratch[0]->slots.end());
+    for (size_t i = 1; i < list_scratch.size() && !out.empty(); i++) {
+        intersect_galloping(out, list_scratch[i]->slots);
+    }
+    return true;
+}
+
+// Check if a query uses only unshared codes
+bool TrigramIndex::is_exact(const std::string& query) {
+    for (char c : query) {
+        if (byte_codes[static_cast<uint8_t>(c)] >= first_shared_code) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Count entries over all lists
+size_t TrigramIndex::get_posting_count() const {
+    size_t total = 0;
+    for (const PostingList& list : lists) {
+        total += list.slots.size() + list.added.size();
+    }
+    return total;
+}
+
+// Sum the storage of the table and every list
+size_t TrigramIndex::get_memory_bytes() const {
+    size_t bytes = list_of_key.capacity() * sizeof(uint32_t) + lists.capacity() * sizeof(PostingList);
+    for (const PostingList& list : lists) {
+        bytes += (list.slots.capacity() + list.added.capacity() + list.removed.capacity()) * sizeof(uint32_t);
+    }
+    bytes += (key_scratch.capacity() + merge_scratch.capacity()) * sizeof(uint32_t);
+    bytes += list_scratch.capacity() * sizeof(PostingList*);
+    return bytes;
+}
@@ -0,0 +1,79 @@
+#ifndef TRIGRAM_INDEX_H
+#define TRIGRAM_INDEX_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Inverted index from title trigrams to task slots, for substring search
+//
+// Every run of three bytes of a text is a trigram; a text can only contain a
+// query if it contains every trigram of the query, so intersecting the
+// posting lists of the query's trigrams gives a small candidate set that the
+// caller verifies against the actual titles.
+//
+// Bytes are mapped to a 64-code alphabet first: ASCII letters (either case),
+// digits and space each get their own code, every other byte shares one of
+// the remaining codes. A trigram is then an 18-bit key that indexes a flat
+// table, with no hashing. Shared codes only add candidates, never lose them.
+//
+// Posting lists are sorted by slot. Inserting a slot above every slot in the
+// list (new tasks in a list without gaps) appends in O(1); other inserts and
+// removals are queued and merged the next time a query uses the list, or
+// when the queue grows past half the list.
+class TrigramIndex {
+public:
+    static constexpr size_t key_count = 64 * 64 * 64;   // Distinct trigram keys
+
+private:
+    // Slots of the texts containing one trigram
+    struct PostingList {
+        std::vector<uint32_t> slots;        // Sorted, unique
+        std::vector<uint32_t> added;        // Inserted out of order since the last merge
+        std::vector<uint32_t> removed;      // Removed since the last merge
+    };
+
+    std::vector<uint32_t> list_of_key;      // Trigram key -> index in lists (UINT32_MAX = none), sized on first insert
+    std::vector<PostingList> lists;         // Posting lists in order of first use
+
+    std::vector<uint32_t> key_scratch;          // Keys of the text being indexed or queried
+    std::vector<PostingList*> list_scratch;     // Lists of the query being answered
+    std::vector<uint32_t> merge_scratch;        // Output of the last merge (swapped with the merged list)
+
+    // Fill key_scratch with the distinct trigram keys of `text`
+    void collect_keys(const std::string& text);
+
+    // Fold a list's queued inserts and removals into its sorted slots
+    void merge_pending(PostingList& list);
+
+public:
+    // Index a text under `slot`
+    void insert(uint32_t slot, const std::string& text);
+
+    // Remove a text indexed under `slot` (must be the text that was inserted)
+    void remove(uint32_t slot, const std::string& text);
+
+    // Remove everything
+    void clear();
+
+    // Fill `out` with the slots (sorted) whose texts contain every trigram of `query`
+    // These are candidates: the caller checks them against the texts.
+    // Returns false if `query` is shorter than 3 bytes and cannot use the index.
+    bool find_candidates(const std::string& query, std::vector<uint32_t>& out);
+
+    // Check if every byte of `query` has its own code, so that the candidates of
+    // a 3-byte query are exact matches
+    static bool is_exact(const std::string& query);
+
+    // Number of trigram keys with a posting list
+    size_t get_list_count() const { return lists.size(); }
+
+    // Number of (trigram, slot) entries, including queued ones
+    size_t get_posting_count() const;
+
+    // Bytes used by the table and the posting lists
+    size_t get_memory_bytes() const;
+};
+
+#endif
@@ -0,0 +1,129 @@
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include "uuid_generator.h"
+
+// Version and variant bits of RFC 9562 UUIDs
+static constexpr uint64_t version_mask = 0xF000ull;              // In `high`
+static constexpr uint64_t variant_mask = 0xC000000000000000ull;  // In `low`
+static constexpr uint64_t variant_bits = 0x8000000000000000ull;  // Binary 10
+
+// Per-thread generator state
+class UuidState {
+private:
+    uint64_t s[4];                  // xoshiro256** state
+
+    uint64_t last_v7_ms = 0;        // Timestamp of the last V7 id
+    uint64_t rand_a = 0;            // 12-bit field of the last V7 id
+    uint64_t rand_b = 0;            // 62-bit field of the last V7 id
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    // Current Unix time in milliseconds
+    static uint64_t unix_ms() {
+        auto now = std::chrono::system_clock::now().time_since_epoch();
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(now).count());
+    }
+
+public:
+    // Seed from the OS entropy source (once per thread)
+    UuidState() {
+        std::random_device device;
+        for (uint64_t& word : s) {
+            word = (static_cast<uint64_t>(device()) << 32) ^ device();
+        }
+        if ((s[0] | s[1] | s[2] | s[3]) == 0) {
+            s[0] = 0x9E3779B97F4A7C15ull;  // All-zero state would only produce zeros
+        }
+    }
+
+    // Next 64 random bits
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // Random UUID
+    TaskId v4() {
+        TaskId id;
+        id.high = (next() & ~version_mask) | 0x4000ull;
+        id.low = (next() & ~variant_mask) | variant_bits;
+        return id;
+    }
+
+    // Time-ordered UUID: | 48-bit ms | ver | 12-bit rand_a | var | 62-bit rand_b |
+    // Within one millisecond (or if the clock steps back) rand_a:rand_b is
+    // treated as a counter and advanced by a random step, so ids from this
+    // thread keep increasing and remain hard to guess.
+    TaskId v7() {
+        constexpr uint64_t rand_b_mask = (1ull << 62) - 1;
+        uint64_t ms = unix_ms();
+
+        if (ms > last_v7_ms) {
+            last_v7_ms = ms;
+            rand_a = next() & 0x7FFull;     // Top bit clear leaves room to count
+            rand_b = next() & rand_b_mask;
+        } else {
+            rand_b += (next() & 0xFFFFFFull) + 1;
+            if (rand_b > rand_b_mask) {
+                rand_b &= rand_b_mask;
+                if (++rand_a > 0xFFFull) {
+                    last_v7_ms++;           // Counter exhausted: borrow the next millisecond
+                    rand_a = 0;
+                }
+            }
+        }
+
+        TaskId id;
+        id.high = (last_v7_ms << 16) | 0x7000ull | rand_a;
+        id.low = rand_b | variant_bits;
+        return id;
+    }
+};
+
+// Generator of the calling thread
+static UuidState& thread_state() {
+    thread_local UuidState state;
+    return state;
+}
+
+// Generate one id
+TaskId generate_uuid(UuidVersion version) {
+    UuidState& state = thread_state();
+    return version == UuidVersion::V7 ? state.v7() : state.v4();
+}
+
+// Generate ids in bulk
+void generate_uuids(UuidVersion version, TaskId* out, size_t count) {
+    UuidState& state = thread_state();
+    if (version == UuidVersion::V7) {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = state.v7();
+        }
+    } else {
+        for (size_t i = 0; i < count; i++) {
+            out[i] = state.v4();
+        }
+    }
+}
+
+// Read the 48-bit timestamp field
+uint64_t uuid_v7_timestamp(const TaskId& id) {
+    return id.high >> 16;
+}
+
+// Id with the given timestamp and all other fields zero
+TaskId uuid_v7_lower_bound(uint64_t unix_ms) {
+    TaskId id;
+    id.high = unix_ms << 16;
+    return id;
+}
@@ -0,0 +1,31 @@
+#ifndef UUID_GENERATOR_H
+#define UUID_GENERATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include "task_id.h"
+
+// Layout of newly generated ids
+enum class UuidVersion {
+    V4,   // 122 random bits (RFC 9562 version 4)
+    V7    // 48-bit Unix millisecond timestamp + random bits, sorts by creation time (version 7)
+};
+
+// Generate one id
+//
+// Each thread owns its generator state (xoshiro256** seeded once from
+// std::random_device), so generation takes no locks and makes no system
+// calls apart from reading the clock for V7. Version 7 ids from one thread
+// are strictly increasing, even within the same millisecond.
+TaskId generate_uuid(UuidVersion version);
+
+// Fill `out[0..count)` with new ids (amortizes the per-thread state lookup for bulk work)
+void generate_uuids(UuidVersion version, TaskId* out, size_t count);
+
+// Creation time of a version 7 id in Unix milliseconds
+uint64_t uuid_v7_timestamp(const TaskId& id);
+
+// Smallest version 7 id that can be minted at `unix_ms` (bound for range queries)
+TaskId uuid_v7_lower_bound(uint64_t unix_ms);
+
+#endif